@@ -0,0 +1,49 @@
+/**
+ * 替换全局 operator new/delete 以统计堆内存分配次数, 每个 benchmark 可执行文件都会链接本文件.
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "bench.hpp"
+
+static thread_local uint64_t allocations = 0;
+
+uint64_t bench::allocation_count() {
+    return allocations;
+}
+
+void *operator new(const std::size_t size) {
+    allocations++;
+    if (auto p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](const std::size_t size) {
+    return operator new(size);
+}
+
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept {
+    allocations++;
+    return std::malloc(size ? size : 1);
+}
+
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept {
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept {
+    std::free(p);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace bench {
+    // 当前线程累计的堆内存分配次数, 由 bench.cpp 中替换的全局 operator new 统计
+    uint64_t allocation_count();
+
+    // 阻止编译器把结果未被使用的计算优化掉
+    template <typename T>
+    inline void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    // 运行 func 共 iterations 次, 输出每次的平均耗时和堆内存分配次数
+    template <typename Func>
+    inline void run(const std::string &name, const uint64_t iterations, Func &&func) {
+        using clock = std::chrono::steady_clock;
+
+        func(); // warm up
+        const auto alloc_begin = allocation_count();
+        const auto time_begin = clock::now();
+        for (uint64_t i = 0; i < iterations; i++) {
+            func();
+        }
+        const auto time_end = clock::now();
+        const auto allocs = allocation_count() - alloc_begin;
+
+        const auto ns = std::chrono::duration<double, std::nano>(time_end - time_begin).count();
+        std::printf("%-48s %12.1f ns/op %10.2f allocs/op\n",
+                    name.c_str(),
+                    ns / static_cast<double>(iterations),
+                    static_cast<double>(allocs) / static_cast<double>(iterations));
+    }
+} // namespace bench
@@ -0,0 +1,39 @@
+#include <random>
+
+#include "../src/utils/base64.hpp"
+#include "bench.hpp"
+#include "vendor/cpp-base64/base64.h"
+
+int main() {
+    std::mt19937 rng(42);
+    std::string bytes(64 * 1024, '\0');
+    for (auto &ch : bytes) ch = static_cast<char>(rng());
+    const auto b64 = cq::utils::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                              static_cast<unsigned int>(bytes.size()));
+    const auto short_b64 = b64.substr(0, 120);
+
+    // vendor/cpp-base64 为原先使用的实现, 仅作为对照
+    bench::run("cpp-base64 decode 64 KiB", 2000, [&] { bench::do_not_optimize(::base64_decode(b64)); });
+    bench::run("base64_decode 64 KiB", 2000, [&] { bench::do_not_optimize(cq::utils::base64_decode(b64)); });
+    std::string out;
+    bench::run("base64_decode_to 64 KiB (reused buffer)", 2000, [&] {
+        out.clear();
+        bench::do_not_optimize(cq::utils::base64_decode_to(out, b64));
+    });
+
+    bench::run("cpp-base64 decode 120 chars", 500000, [&] {
+        bench::do_not_optimize(::base64_decode(short_b64));
+    });
+    bench::run("base64_decode 120 chars", 500000, [&] {
+        bench::do_not_optimize(cq::utils::base64_decode(short_b64));
+    });
+
+    bench::run("cpp-base64 encode 64 KiB", 2000, [&] {
+        bench::do_not_optimize(::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                               static_cast<unsigned int>(bytes.size())));
+    });
+    bench::run("base64_encode 64 KiB", 2000, [&] {
+        bench::do_not_optimize(cq::utils::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                                        static_cast<unsigned int>(bytes.size())));
+    });
+}
@@ -0,0 +1,93 @@
+#include "cqcppsdk/cqcppsdk.h"
+
+#include "bench.hpp"
+#include "vendor/legacy-message/message.hpp"
+
+using cq::message::Message;
+using cq::message::MessageSegment;
+
+int main() {
+    const std::string typical = "[CQ:at,qq=123456789] 你好, 今天的天气怎么样? [CQ:face,id=14][CQ:image,file=abc.jpg]";
+
+    std::string long_message;
+    for (auto i = 0; i < 200; i++) {
+        long_message += "[CQ:at,qq=" + std::to_string(10000 + i) + "] ";
+    }
+
+    // vendor/legacy-message 为原先基于 std::list 的实现, 仅作为对照
+    bench::run("legacy parse typical message", 200000, [&] { bench::do_not_optimize(legacy::Message(typical)); });
+    bench::run("parse typical message", 200000, [&] { bench::do_not_optimize(Message(typical)); });
+    bench::run("legacy parse 200 at codes", 2000, [&] { bench::do_not_optimize(legacy::Message(long_message)); });
+    bench::run("parse 200 at codes", 2000, [&] { bench::do_not_optimize(Message(long_message)); });
+
+    bench::run("scan 200 at codes for mentions", 2000, [&] {
+        size_t mentions = 0;
+        cq::message::scan(
+            long_message,
+            [](std::string_view) {},
+            [&](std::string_view type, const cq::message::ParamsView &) { mentions += type == "at"; });
+        bench::do_not_optimize(mentions);
+    });
+
+    const Message long_parsed(long_message);
+    bench::run("sum at user ids via data map", 2000, [&] {
+        int64_t sum = 0;
+        for (const auto &seg : long_parsed) {
+            if (seg.type == cq::message::SegmentType::AT) sum += std::stoll(seg.data.at("qq"));
+        }
+        bench::do_not_optimize(sum);
+    });
+    const auto long_typed = cq::message::to_typed(long_parsed);
+    bench::run("sum at user ids via typed segments", 2000, [&] {
+        int64_t sum = 0;
+        for (const auto &seg : long_typed) {
+            if (const auto at = std::get_if<cq::message::AtSegment>(&seg)) sum += at->user_id;
+        }
+        bench::do_not_optimize(sum);
+    });
+
+    bench::run("construct at segment", 200000, [&] { bench::do_not_optimize(MessageSegment::at(123456789)); });
+    bench::run("construct share segment", 200000, [&] {
+        bench::do_not_optimize(MessageSegment::share("http://example.com", "title", "content", "http://image"));
+    });
+
+    const Message parsed(typical);
+    const legacy::Message legacy_parsed(typical);
+    bench::run("legacy serialize typical message", 200000, [&] {
+        bench::do_not_optimize(std::string(legacy_parsed));
+    });
+    bench::run("serialize typical message", 200000, [&] { bench::do_not_optimize(std::string(parsed)); });
+    bench::run("serialize 200 at codes", 2000, [&] { bench::do_not_optimize(std::string(long_parsed)); });
+    const Message parsed_copy(typical);
+    bench::run("compare typical messages", 200000, [&] { bench::do_not_optimize(parsed == parsed_copy); });
+    bench::run("hash typical message", 200000, [&] { bench::do_not_optimize(cq::message::hash(parsed)); });
+    bench::run("legacy extract plain text", 200000, [&] {
+        bench::do_not_optimize(legacy_parsed.extract_plain_text());
+    });
+    bench::run("extract plain text", 200000, [&] { bench::do_not_optimize(parsed.extract_plain_text()); });
+
+    bench::run("append 1000 pieces with +=", 200, [&] {
+        Message reply;
+        for (auto i = 0; i < 1000; i++) {
+            reply += MessageSegment::text("line ");
+            if (i % 10 == 0) reply += MessageSegment::at(10000 + i);
+        }
+        bench::do_not_optimize(reply);
+    });
+
+    const std::string reply_text = "今天的天气不错";
+    bench::run("build at reply with +", 200000, [&] {
+        bench::do_not_optimize("[CQ:at,qq=" + std::to_string(123456789) + "] " + reply_text);
+    });
+    bench::run("build at reply with format", 200000, [&] {
+        bench::do_not_optimize(
+            cq::message::format(CQ_MESSAGE_FORMAT("[CQ:at,qq={}] {}"), 123456789, cq::message::raw(reply_text)));
+    });
+
+    const std::string plain_text(200, 'x');
+    std::string escaped_text;
+    for (auto i = 0; i < 20; i++) escaped_text += "&#91;hello&#93;&amp;";
+    bench::run("escape plain text", 200000, [&] { bench::do_not_optimize(cq::message::escape(plain_text)); });
+    bench::run("unescape text", 200000, [&] { bench::do_not_optimize(cq::message::unescape(escaped_text)); });
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "cqcppsdk/cqcppsdk.h"
+
+#include <codecvt>
+#include <locale>
+
+#include "bench.hpp"
+
+using cq::utils::string_from_coolq;
+using cq::utils::string_to_coolq;
+using cq::utils::string_to_coolq_cstr;
+
+// 原先 ws2s/s2ws 的实现, 仅作为对照
+static std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> make_converter() {
+    return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>();
+}
+
+int main() {
+    const std::string ascii = "[CQ:at,qq=123456789] hello, how is the weather today? [CQ:face,id=14]";
+    const std::string chinese = u8"[CQ:at,qq=123456789] 你好, 今天的天气怎么样? [CQ:face,id=14]";
+    std::string long_chinese;
+    for (auto i = 0; i < 100; i++) long_chinese += chinese;
+
+    const auto ascii_gb = string_to_coolq(ascii);
+    const auto chinese_gb = string_to_coolq(chinese);
+    const auto long_chinese_gb = string_to_coolq(long_chinese);
+
+    bench::run("string_to_coolq ascii message", 1000000, [&] { bench::do_not_optimize(string_to_coolq(ascii)); });
+    bench::run("string_to_coolq chinese message", 1000000, [&] {
+        bench::do_not_optimize(string_to_coolq(chinese));
+    });
+    bench::run("string_to_coolq 100 chinese messages", 10000, [&] {
+        bench::do_not_optimize(string_to_coolq(long_chinese));
+    });
+    bench::run("string_to_coolq_cstr chinese message", 1000000, [&] {
+        bench::do_not_optimize(string_to_coolq_cstr(chinese));
+    });
+    bench::run("string_from_coolq ascii message", 1000000, [&] {
+        bench::do_not_optimize(string_from_coolq(ascii_gb));
+    });
+    bench::run("string_from_coolq chinese message", 1000000, [&] {
+        bench::do_not_optimize(string_from_coolq(chinese_gb));
+    });
+    bench::run("string_from_coolq 100 chinese messages", 10000, [&] {
+        bench::do_not_optimize(string_from_coolq(long_chinese_gb));
+    });
+
+    const std::string path = u8"C:\\Program Files\\酷Q Pro\\data\\app\\io.github.richardchien.demo\\";
+    const auto wpath = cq::utils::s2ws(path);
+    bench::run("wstring_convert s2ws path", 200000, [&] { bench::do_not_optimize(make_converter().from_bytes(path)); });
+    bench::run("s2ws path", 200000, [&] { bench::do_not_optimize(cq::utils::s2ws(path)); });
+    bench::run("wstring_convert ws2s path", 200000, [&] { bench::do_not_optimize(make_converter().to_bytes(wpath)); });
+    bench::run("ws2s path", 200000, [&] { bench::do_not_optimize(cq::utils::ws2s(wpath)); });
+}
@@ -0,0 +1,48 @@
+#include "cqcppsdk/cqcppsdk.h"
+
+#include "bench.hpp"
+
+using cq::GroupMember;
+using cq::ObjectHelper;
+
+// 生成接近实际的群成员信息, 约一成为管理员
+static GroupMember make_member(const int64_t user_id) {
+    GroupMember member;
+    member.group_id = 123456789;
+    member.user_id = user_id;
+    member.nickname = "nickname of " + std::to_string(user_id);
+    member.card = user_id % 3 ? "card " + std::to_string(user_id) : "";
+    member.sex = static_cast<cq::Sex>(user_id % 2);
+    member.age = static_cast<int32_t>(16 + user_id % 40);
+    member.area = "area";
+    member.join_time = 1500000000;
+    member.last_sent_time = 1600000000;
+    member.level = "level";
+    member.role = user_id % 10 ? cq::GroupRole::MEMBER : cq::GroupRole::ADMIN;
+    member.card_changeable = true;
+    return member;
+}
+
+int main() {
+    const auto member_b64 = ObjectHelper::to_base64(make_member(10000));
+
+    std::vector<GroupMember> members;
+    for (auto i = 0; i < 2000; i++) members.push_back(make_member(10000 + i));
+    const auto list_b64 = ObjectHelper::multi_to_base64(members);
+
+    bench::run("base64 decode 2000 member list", 200, [&] {
+        bench::do_not_optimize(cq::utils::base64_decode(list_b64));
+    });
+    bench::run("from_base64 group member", 200000, [&] {
+        bench::do_not_optimize(ObjectHelper::from_base64<GroupMember>(member_b64));
+    });
+    bench::run("multi_from_base64 2000 group members", 200, [&] {
+        bench::do_not_optimize(ObjectHelper::multi_from_base64<std::vector<GroupMember>>(list_b64));
+    });
+    bench::run("GroupMemberTable 2000 members, count admins", 200, [&] {
+        const auto table = ObjectHelper::from_base64<cq::GroupMemberTable>(list_b64);
+        size_t admins = 0;
+        for (size_t i = 0; i < table.size(); i++) admins += table.role(i) != cq::GroupRole::MEMBER;
+        bench::do_not_optimize(admins);
+    });
+}
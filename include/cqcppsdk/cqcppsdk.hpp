@@ -9,4 +9,8 @@
 #include "../../src/core/logging.hpp"
 #include "../../src/core/menu.hpp"
 #include "../../src/core/message.hpp"
+#include "../../src/core/message_split.hpp"
+#include "../../src/core/message_typed.hpp"
+#include "../../src/core/message_view.hpp"
+#include "../../src/core/segment_type.hpp"
 #include "../../src/utils/string.hpp"
@@ -38,9 +38,17 @@ namespace dolores {
             return cq::send_message(event.target, message, at_user);
         }
 
+        int64_t send(const cq::EncodedMessage &message, const bool at_user = false) const {
+            return cq::send_message(event.target, message, at_user);
+        }
+
         int64_t reply(const std::string &message) const {
             return send(message, true);
         }
+
+        int64_t reply(const cq::EncodedMessage &message) const {
+            return send(message, true);
+        }
     };
 
     template <typename E>
@@ -52,6 +60,14 @@ namespace dolores {
     struct Current<cq::MessageEvent> : CurrentBase<cq::MessageEvent> {
         using CurrentBase<cq::MessageEvent>::CurrentBase;
 
+        const cq::message::Message &message() const {
+            return event.parsed_message();
+        }
+
+        const std::string &plain_text() const {
+            return event.plain_text();
+        }
+
         std::string command_starter() const {
             return std::string(matcher_data.get<std::string_view>(matchers::command::STARTER, ""));
         }
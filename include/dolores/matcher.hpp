@@ -432,6 +432,20 @@ namespace dolores {
             std::shared_ptr<MessageMatcher> _sub_matcher;
         };
 
+        // 消息包含任意一种指定类型的消息段时匹配, 如 has_segment({SegmentType::IMAGE, SegmentType::RECORD})
+        class has_segment : public MatcherBase {
+        public:
+            explicit has_segment(const cq::message::SegmentTypeMask types) : _types(types) {
+            }
+
+            bool match(const cq::MessageEvent &event, StrAnyMap &matcher_data) const override {
+                return event.parsed_message().types().has_any(_types);
+            }
+
+        protected:
+            cq::message::SegmentTypeMask _types;
+        };
+
         class user : public MatcherBase {
         public:
             user() = default;
@@ -12,6 +12,9 @@ namespace cq {
         send_private_message(0, "");
         send_group_message(0, "");
         send_discuss_message(0, "");
+        send_private_message(0, EncodedMessage(""));
+        send_group_message(0, EncodedMessage(""));
+        send_discuss_message(0, EncodedMessage(""));
         delete_message(0);
 
         send_like(0, 0);
@@ -38,6 +41,7 @@ namespace cq {
         get_group_list();
         get_group_info(0, false);
         get_group_member_list(0);
+        get_group_member_table(0);
         get_group_member_info(0, 0, false);
 
         get_cookies("");
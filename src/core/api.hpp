@@ -4,6 +4,7 @@
 
 #include "event.hpp"
 #include "exception.hpp"
+#include "message_format.hpp"
 #include "type.hpp"
 
 namespace cq {
@@ -22,27 +23,65 @@ namespace cq {
 
     void _init_api();
 
+    // 已转换为酷Q编码 (GB18030) 的消息, 用于多次发送同一条消息 (如向多个群广播), 只转换一次编码
+    class EncodedMessage {
+    public:
+        explicit EncodedMessage(const std::string &message) : bytes_(utils::string_to_coolq(message)) {
+        }
+
+        // 从已是酷Q编码的字节构造, 不做转换
+        static EncodedMessage from_coolq(std::string bytes) {
+            EncodedMessage encoded;
+            encoded.bytes_ = std::move(bytes);
+            return encoded;
+        }
+
+        const std::string &bytes() const noexcept {
+            return bytes_;
+        }
+
+        const char *c_str() const noexcept {
+            return bytes_.c_str();
+        }
+
+    private:
+        EncodedMessage() = default;
+
+        std::string bytes_;
+    };
+
     // 发送私聊消息
     int64_t send_private_message(const int64_t user_id, const std::string &message) noexcept(false);
+    int64_t send_private_message(const int64_t user_id, const EncodedMessage &message) noexcept(false);
     // 发送群消息
     int64_t send_group_message(const int64_t group_id, const std::string &message) noexcept(false);
+    int64_t send_group_message(const int64_t group_id, const EncodedMessage &message) noexcept(false);
     // 发送讨论组消息
     int64_t send_discuss_message(const int64_t discuss_id, const std::string &message) noexcept(false);
+    int64_t send_discuss_message(const int64_t discuss_id, const EncodedMessage &message) noexcept(false);
 
-    // 向 target 指定的目标发送消息
-    inline int64_t send_message(const Target &target, const std::string &message,
-                                const bool at_user = false) noexcept(false) {
+    // 在消息前加上 @某人
+    inline std::string _at_prefixed(const int64_t user_id, const std::string &message) {
+        return message::format(CQ_MESSAGE_FORMAT("[CQ:at,qq={}] {}"), user_id, message::raw(message));
+    }
+
+    // CQ 码前缀只含 ASCII 字符, 在 GB18030 下字节相同, 可直接拼接在已编码的消息前
+    inline EncodedMessage _at_prefixed(const int64_t user_id, const EncodedMessage &message) {
+        return EncodedMessage::from_coolq(
+            message::format(CQ_MESSAGE_FORMAT("[CQ:at,qq={}] {}"), user_id, message::raw(message.bytes())));
+    }
+
+    template <typename Message>
+    inline int64_t _send_message(const Target &target, const Message &message, const bool at_user) {
         if (target.group_id.has_value()) {
             if (at_user && target.user_id.has_value()) {
-                return send_group_message(target.group_id.value(),
-                                          "[CQ:at,qq=" + to_string(target.user_id.value()) + "] " + message);
+                return send_group_message(target.group_id.value(), _at_prefixed(target.user_id.value(), message));
             }
             return send_group_message(target.group_id.value(), message);
         }
         if (target.discuss_id.has_value()) {
             if (at_user && target.user_id.has_value()) {
-                return send_discuss_message(target.discuss_id.value(),
-                                            "[CQ:at,qq=" + to_string(target.user_id.value()) + "] " + message);
+                return send_discuss_message(target.discuss_id.value(), _at_prefixed(target.user_id.value(), message));
             }
             return send_discuss_message(target.discuss_id.value(), message);
         }
@@ -52,6 +91,18 @@ namespace cq {
         throw ApiError(ApiError::INVALID_TARGET);
     }
 
+    // 向 target 指定的目标发送消息
+    inline int64_t send_message(const Target &target, const std::string &message,
+                                const bool at_user = false) noexcept(false) {
+        return _send_message(target, message, at_user);
+    }
+
+    // 向 target 指定的目标发送已编码的消息
+    inline int64_t send_message(const Target &target, const EncodedMessage &message,
+                                const bool at_user = false) noexcept(false) {
+        return _send_message(target, message, at_user);
+    }
+
     // 撤回消息(可撤回自己 2 分钟内发的消息和比自己更低权限的群成员发的消息)
     void delete_message(const int64_t message_id) noexcept(false);
 
@@ -103,6 +154,8 @@ namespace cq {
     Group get_group_info(const int64_t group_id, const bool no_cache = false) noexcept(false);
     // 获取群成员列表
     std::vector<GroupMember> get_group_member_list(const int64_t group_id) noexcept(false);
+    // 获取群成员列表, 按列存储, 字符串字段在访问时才解码
+    GroupMemberTable get_group_member_table(const int64_t group_id) noexcept(false);
     // 获取群成员信息
     GroupMember get_group_member_info(const int64_t group_id, const int64_t user_id,
                                       const bool no_cache = false) noexcept(false);
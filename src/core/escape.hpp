@@ -0,0 +1,125 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <string_view>
+
+#include "../utils/simd.hpp"
+
+namespace cq::message {
+    inline std::string_view _escape_entity(const char ch) {
+        switch (ch) {
+        case '&':
+            return "&amp;";
+        case '[':
+            return "&#91;";
+        case ']':
+            return "&#93;";
+        default:
+            return "&#44;";
+        }
+    }
+
+    // 若 str 以转义实体开头, 返回其代表的字符, 否则返回 '\0'
+    inline char _unescape_entity(const std::string_view str) {
+        if (str.size() < 5 || str[4] != ';') return '\0';
+        const auto entity = str.substr(0, 5);
+        if (entity == "&amp;") return '&';
+        if (entity == "&#91;") return '[';
+        if (entity == "&#93;") return ']';
+        if (entity == "&#44;") return ',';
+        return '\0';
+    }
+
+    // 在 [first, last) 中查找第一个需要转义的字符
+    inline const char *_find_escapable(const char *first, const char *last, const bool escape_comma) {
+        return utils::simd::find_any_of(first, last, '&', '[', ']', escape_comma ? ',' : '&');
+    }
+
+    // 计算 CQ 码转义后的长度, 每个需要转义的字符变为 5 个字符
+    inline size_t escaped_size(const std::string_view str, const bool escape_comma = true) {
+        const auto last = str.data() + str.size();
+        auto size = str.size();
+        for (auto p = _find_escapable(str.data(), last, escape_comma); p != last;
+             p = _find_escapable(p + 1, last, escape_comma)) {
+            size += 4;
+        }
+        return size;
+    }
+
+    // 对字符串做 CQ 码转义, 并将结果追加到 out 末尾
+    inline void escape_to(std::string &out, const std::string_view str, const bool escape_comma = true) {
+        const auto last = str.data() + str.size();
+        for (auto p = str.data();;) {
+            const auto q = _find_escapable(p, last, escape_comma);
+            out.append(p, q - p);
+            if (q == last) return;
+            out += _escape_entity(*q);
+            p = q + 1;
+        }
+    }
+
+    // 对字符串做 CQ 码转义
+    inline std::string escape(const std::string_view str, const bool escape_comma = true) {
+        std::string res;
+        res.reserve(escaped_size(str, escape_comma));
+        escape_to(res, str, escape_comma);
+        return res;
+    }
+
+    // 对字符串做 CQ 码转义, 无需转义时直接返回原字符串, 不进行复制
+    inline std::string escape(std::string &&str, const bool escape_comma = true) {
+        const auto last = str.data() + str.size();
+        if (_find_escapable(str.data(), last, escape_comma) == last) return std::move(str);
+        return escape(std::string_view(str), escape_comma);
+    }
+
+    inline std::string escape(const char *str, const bool escape_comma = true) {
+        return escape(std::string_view(str), escape_comma);
+    }
+
+    // 对字符串做 CQ 码去转义, 并将结果追加到 out 末尾
+    inline void unescape_to(std::string &out, const std::string_view str) {
+        for (size_t pos = 0;;) {
+            const auto amp = str.find('&', pos);
+            out.append(str.substr(pos, amp - pos));
+            if (amp == std::string_view::npos) return;
+            if (const auto ch = _unescape_entity(str.substr(amp))) {
+                out += ch;
+                pos = amp + 5;
+            } else {
+                out += '&';
+                pos = amp + 1;
+            }
+        }
+    }
+
+    // 对字符串做 CQ 码去转义
+    inline std::string unescape(const std::string_view str) {
+        std::string res;
+        res.reserve(str.size());
+        unescape_to(res, str);
+        return res;
+    }
+
+    // 对字符串做 CQ 码去转义, 去转义只会使字符串变短, 因此直接在原字符串上进行, 不进行复制
+    inline std::string unescape(std::string &&str) {
+        size_t w = 0;
+        for (size_t r = 0;;) {
+            const auto amp = str.find('&', r);
+            const auto stop = amp != std::string::npos ? amp : str.size();
+            if (w != r) std::char_traits<char>::move(&str[w], &str[r], stop - r);
+            w += stop - r;
+            if (amp == std::string::npos) break;
+            const auto ch = _unescape_entity(std::string_view(str).substr(amp));
+            str[w++] = ch ? ch : '&';
+            r = amp + (ch ? 5 : 1);
+        }
+        str.resize(w);
+        return std::move(str);
+    }
+
+    inline std::string unescape(const char *str) {
+        return unescape(std::string_view(str));
+    }
+} // namespace cq::message
@@ -2,9 +2,14 @@
 
 #include "common.hpp"
 
+#include "message_view.hpp"
 #include "target.hpp"
 #include "type.hpp"
 
+namespace cq::message {
+    struct Message;
+} // namespace cq::message
+
 namespace cq {
     struct Event {
         time_t time; // 酷Q触发事件的时间
@@ -84,6 +89,30 @@ namespace cq {
               message(std::move(message)),
               font(font) {
         }
+
+        // 消息的只读视图, 不做解析和内存分配
+        message::MessageView message_view() const {
+            return message::MessageView(message);
+        }
+
+        // 替换消息内容并丢弃已缓存的解析结果
+        void set_message(std::string message) {
+            this->message = std::move(message);
+            _parsed.reset();
+        }
+
+        // 解析后的消息, 首次访问时解析并缓存, 同一事件的各个处理函数共享同一份结果;
+        // message 被修改后 (无论是否通过 set_message), 下次访问时重新解析, 此前返回的引用随之失效
+        inline const message::Message &parsed_message() const;
+
+        // 消息中的纯文本部分, 与 parsed_message() 一同缓存
+        inline const std::string &plain_text() const;
+
+    private:
+        struct _ParsedMessage;
+        mutable std::shared_ptr<_ParsedMessage> _parsed;
+
+        inline _ParsedMessage &_parse() const;
     };
 
     // 通知事件
@@ -3,111 +3,123 @@
 #include "common.hpp"
 
 #include "api.hpp"
+#include "escape.hpp"
+#include "message_format.hpp"
+#include "message_view.hpp"
+#include "segment_type.hpp"
 
-namespace cq::message {
-    // 对字符串做 CQ 码转义
-    inline std::string escape(const std::string &str, const bool escape_comma = true) {
-        using cq::utils::string_replace;
-
-        std::string res = str;
-        string_replace(res, "&", "&amp;");
-        string_replace(res, "[", "&#91;");
-        string_replace(res, "]", "&#93;");
-        if (escape_comma) string_replace(res, ",", "&#44;");
-        return res;
-    }
-
-    // 对字符串做 CQ 码去转义
-    inline std::string unescape(const std::string &str) {
-        using cq::utils::string_replace;
-
-        std::string res = str;
-        string_replace(res, "&#44;", ",");
-        string_replace(res, "&#91;", "[");
-        string_replace(res, "&#93;", "]");
-        string_replace(res, "&amp;", "&");
-        return res;
-    }
+#include "../utils/flat_map.hpp"
+#include "../utils/small_vector.hpp"
 
+namespace cq::message {
     // 消息段 (即 CQ 码)
     struct MessageSegment {
-        std::string type; // 消息段类型 (即 CQ 码的功能名)
-        std::map<std::string, std::string> data; // 消息段数据 (即 CQ 码参数), 字符串全部使用未经 CQ 码转义的原始文本
+        // 消息段数据的类型, 按键有序存储, 不超过 4 个参数时不进行额外的堆内存分配
+        using Data = utils::FlatMap<std::string, std::string, 4>;
 
-        // 转换为字符串形式
-        operator std::string() const {
-            std::string s;
+        SegmentType type; // 消息段类型 (即 CQ 码的功能名)
+        Data data; // 消息段数据 (即 CQ 码参数), 字符串全部使用未经 CQ 码转义的原始文本
+
+        // 字符串形式的精确长度
+        size_t serialized_size() const {
             if (this->type.empty()) {
-                return s;
+                return 0;
             }
-            if (this->type == "text") {
+            if (this->type == SegmentType::TEXT) {
+                const auto it = this->data.find("text");
+                return it != this->data.end() ? escaped_size(it->second, false) : 0;
+            }
+            auto size = 5 + this->type.name().size(); // "[CQ:" + 功能名 + "]"
+            for (const auto &item : this->data) {
+                size += 2 + item.first.size() + escaped_size(item.second, true); // "," + 键 + "=" + 值
+            }
+            return size;
+        }
+
+        // 将字符串形式追加到 out 末尾
+        void append_to(std::string &out) const {
+            if (this->type.empty()) {
+                return;
+            }
+            if (this->type == SegmentType::TEXT) {
                 if (const auto it = this->data.find("text"); it != this->data.end()) {
-                    s += escape((*it).second, false);
+                    escape_to(out, it->second, false);
                 }
             } else {
-                s += "[CQ:" + this->type;
+                out += "[CQ:";
+                out += this->type.name();
                 for (const auto &item : this->data) {
-                    s += "," + item.first + "=" + escape(item.second, true);
+                    out += ',';
+                    out += item.first;
+                    out += '=';
+                    escape_to(out, item.second, true);
                 }
-                s += "]";
+                out += ']';
             }
+        }
+
+        // 转换为字符串形式
+        operator std::string() const {
+            std::string s;
+            s.reserve(this->serialized_size());
+            this->append_to(s);
             return s;
         }
 
         // 纯文本
         static MessageSegment text(const std::string &text) {
-            return {"text", {{"text", text}}};
+            return {SegmentType::TEXT, {{"text", text}}};
         }
 
         // Emoji 表情
         static MessageSegment emoji(const uint32_t id) {
-            return {"emoji", {{"id", to_string(id)}}};
+            return {SegmentType::EMOJI, {{"id", to_string(id)}}};
         }
 
         // QQ 表情
         static MessageSegment face(const int id) {
-            return {"face", {{"id", to_string(id)}}};
+            return {SegmentType::FACE, {{"id", to_string(id)}}};
         }
 
         // 图片
         static MessageSegment image(const std::string &file) {
-            return {"image", {{"file", file}}};
+            return {SegmentType::IMAGE, {{"file", file}}};
         }
 
         // 语音
         static MessageSegment record(const std::string &file, const bool magic = false) {
-            return {"record", {{"file", file}, {"magic", to_string(magic)}}};
+            return {SegmentType::RECORD, {{"file", file}, {"magic", to_string(magic)}}};
         }
 
         // @某人
         static MessageSegment at(const int64_t user_id) {
-            return {"at", {{"qq", to_string(user_id)}}};
+            return {SegmentType::AT, {{"qq", to_string(user_id)}}};
         }
 
         // 猜拳魔法表情
         static MessageSegment rps() {
-            return {"rps", {}};
+            return {SegmentType::RPS, {}};
         }
 
         // 掷骰子魔法表情
         static MessageSegment dice() {
-            return {"dice", {}};
+            return {SegmentType::DICE, {}};
         }
 
         // 戳一戳
         static MessageSegment shake() {
-            return {"shake", {}};
+            return {SegmentType::SHAKE, {}};
         }
 
         // 匿名发消息
         static MessageSegment anonymous(const bool ignore_failure = false) {
-            return {"anonymous", {{"ignore", to_string(ignore_failure)}}};
+            return {SegmentType::ANONYMOUS, {{"ignore", to_string(ignore_failure)}}};
         }
 
         // 链接分享
         static MessageSegment share(const std::string &url, const std::string &title, const std::string &content = "",
                                     const std::string &image_url = "") {
-            return {"share", {{"url", url}, {"title", title}, {"content", content}, {"image", image_url}}};
+            return {SegmentType::SHARE, {{"url", url}, {"title", title}, {"content", content}, {"image", image_url}}};
         }
 
         enum class ContactType { USER, GROUP };
@@ -115,7 +127,7 @@ namespace cq::message {
         // 推荐好友, 推荐群
         static MessageSegment contact(const ContactType &type, const int64_t id) {
             return {
-                "contact",
+                SegmentType::CONTACT,
                 {
                     {"type", type == ContactType::USER ? "qq" : "group"},
                     {"id", to_string(id)},
@@ -127,7 +139,7 @@ namespace cq::message {
         static MessageSegment location(const double latitude, const double longitude, const std::string &title = "",
                                        const std::string &content = "") {
             return {
-                "location",
+                SegmentType::LOCATION,
                 {
                     {"lat", to_string(latitude)},
                     {"lon", to_string(longitude)},
@@ -139,19 +151,19 @@ namespace cq::message {
 
         // 音乐
         static MessageSegment music(const std::string &type, const int64_t id) {
-            return {"music", {{"type", type}, {"id", to_string(id)}}};
+            return {SegmentType::MUSIC, {{"type", type}, {"id", to_string(id)}}};
         }
 
         // 音乐
         static MessageSegment music(const std::string &type, const int64_t id, const int32_t style) {
-            return {"music", {{"type", type}, {"id", to_string(id)}, {"style", to_string(style)}}};
+            return {SegmentType::MUSIC, {{"type", type}, {"id", to_string(id)}, {"style", to_string(style)}}};
         }
 
         // 音乐自定义分享
         static MessageSegment music(const std::string &url, const std::string &audio_url, const std::string &title,
                                     const std::string &content = "", const std::string &image_url = "") {
             return {
-                "music",
+                SegmentType::MUSIC,
                 {
                     {"type", "custom"},
                     {"url", url},
@@ -164,118 +176,60 @@ namespace cq::message {
         }
     };
 
-    struct Message : std::list<MessageSegment> {
-        using std::list<MessageSegment>::list;
+    // 消息, 即消息段的序列; 消息段连续存储, 不超过 4 个时不进行额外的堆内存分配
+    struct Message : utils::SmallVector<MessageSegment, 4> {
+        using Segments = utils::SmallVector<MessageSegment, 4>;
+        using Segments::SmallVector;
 
         // 将 C 字符串形式的消息转换为 Message 对象
         Message(const char *msg_str) : Message(std::string(msg_str)) {
         }
 
         // 将字符串形式的消息转换为 Message 对象
-        Message(const std::string &msg_str) {
-            using cq::utils::string_trim;
-
-            // 定义字符流操作
-            size_t idx = 0;
-            const auto has_next = [&] { return idx < msg_str.length(); };
-            const auto next = [&] { return msg_str[idx++]; };
-            const auto move_rel = [&](const size_t rel_steps = 0) { idx += rel_steps; };
-            const auto peek = [&] { return msg_str[idx]; };
-            const auto peek_n = [&](const size_t count = 1) {
-                return msg_str.substr(idx, std::min(count, msg_str.length() - idx));
-            };
-
-            // 判断当前位置是否 CQ 码开头
-            const auto is_cq_code_begin = [&](const char ch) { return ch == '[' && peek_n(3) == "CQ:"; };
-
-            // 定义状态
-            enum { S0, S1 } state = S0;
-
-            std::string temp_text; // 暂存以后可能作为 text 类型消息段保存的内容
-            std::string cq_code; // 不包含 [CQ: 和 ] 的 CQ 码内容, 如 image,file=abc.jpg
-
-            const auto save_temp_text = [&] {
-                if (!temp_text.empty()) this->push_back(MessageSegment::text(unescape(temp_text)));
-                temp_text.clear();
-                cq_code.clear();
-            };
+        Message(const std::string &msg_str) : Message(MessageView(msg_str)) {
+        }
 
-            const auto save_cq_code = [&] {
-                std::istringstream iss(cq_code);
-                std::string type, param;
-                std::map<std::string, std::string> data;
-                getline(iss, type, ','); // 读取功能名
-                while (iss) {
-                    getline(iss, param, ','); // 读取一个参数
-                    string_trim(param);
-                    if (param.empty()) continue;
-                    const auto eq_pos = param.find('=');
-                    data.emplace(
-                        std::string(param.begin(), param.begin() + eq_pos),
-                        eq_pos != std::string::npos ? std::string(param.begin() + eq_pos + 1, param.end()) : "");
-                    param.clear();
+        // 将消息视图转换为 Message 对象, 此时才真正复制和去转义各消息段的内容
+        explicit Message(const MessageView &view) {
+            for (const auto &seg_view : view) {
+                if (!seg_view.is_code) {
+                    this->Segments::push_back(MessageSegment::text(unescape(seg_view.text)));
+                    types_.insert(SegmentType::TEXT);
+                    continue;
                 }
-                this->push_back(MessageSegment{std::move(type), std::move(data)});
-                cq_code.clear();
-                temp_text.clear();
-            };
-
-            /*
-              状态图:
-                 +---+            +---+
-                 |   |            |   |
-                 | other          | other
-                 v   |            v   |
-              +--+-+ |         +--+-+ |      +----+
-              | S0 +-+--[CQ:-->+ S1 +-+--]-->+ SF |
-              +--+-+           +--+-+        +----+
-                 ^                |
-                 |                |
-                 +---[CQ:-back----+
-            */
-            while (has_next()) {
-                const auto ch = next();
-                switch (state) {
-                case S0: // 处理纯文本或 CQ 码开头
-                    if (is_cq_code_begin(ch)) {
-                        // 潜在的 CQ 码开始
-                        save_temp_text();
-                        temp_text += "[CQ:";
-                        move_rel(+3); // 跳过 CQ:
-                        state = S1;
-                    } else {
-                        temp_text += ch;
-                    }
-                    break;
-                case S1: // 处理 CQ 码内容
-                    if (is_cq_code_begin(ch)) {
-                        move_rel(-1); // 回退 [
-                        state = S0; // 回到 S0
-                    } else if (ch == ']') {
-                        // CQ 码结束
-                        save_cq_code();
-                        state = S0;
-                    } else {
-                        cq_code += ch;
-                        temp_text += ch;
-                    }
-                    break;
+                MessageSegment seg{SegmentType(seg_view.type), {}};
+                for (const auto &param : seg_view.params) {
+                    seg.data.emplace(std::string(param.key), unescape(param.value));
                 }
+                types_.insert(seg.type.kind());
+                this->Segments::push_back(std::move(seg));
             }
-            save_temp_text(); // 保存剩余的临时文本
-            this->reduce();
+            types_dirty_ = false;
         }
 
         // 将消息段转换为 Message 对象
-        Message(const MessageSegment &seg) {
-            this->push_back(seg);
+        Message(const MessageSegment &seg) : types_(seg.type.kind()), types_dirty_(false) {
+            this->Segments::push_back(seg);
         }
 
-        // 将 Message 对象转换为字符串形式的消息
+        // 字符串形式的精确长度
+        size_t serialized_size() const {
+            size_t size = 0;
+            for (const auto &seg : *this) size += seg.serialized_size();
+            return size;
+        }
+
+        // 将字符串形式的消息追加到 out 末尾, 调用方可先按 serialized_size() 预留空间
+        void append_to(std::string &out) const {
+            for (const auto &seg : *this) seg.append_to(out);
+        }
+
+        // 将 Message 对象转换为字符串形式的消息, 只进行一次内存分配
         operator std::string() const {
-            return std::accumulate(this->begin(), this->end(), std::string(), [](const auto &seg1, const auto &seg2) {
-                return std::string(seg1) + std::string(seg2);
-            });
+            std::string s;
+            s.reserve(this->serialized_size());
+            this->append_to(s);
+            return s;
         }
 
         // 向指定主体发送消息
@@ -287,7 +241,7 @@ namespace cq::message {
         std::string extract_plain_text() const {
             std::string result;
             for (const auto &seg : *this) {
-                if (seg.type == "text") {
+                if (seg.type == SegmentType::TEXT) {
                     result += seg.data.at("text") + " ";
                 }
             }
@@ -297,44 +251,71 @@ namespace cq::message {
             return result;
         }
 
-        // 获取消息段链表的引用
-        std::list<MessageSegment> &segments() {
-            return *this;
+        // 消息中出现的消息段类型, 解析和拼接时同步维护; 通过非 const 接口访问消息段后, 下次查询时重新计算.
+        // 注意: 查询之后再通过此前取得的引用或迭代器修改消息段类型, 不会反映在结果中
+        SegmentTypeMask types() const {
+            if (types_dirty_) {
+                types_ = SegmentTypeMask();
+                for (const auto &seg : *this) types_.insert(seg.type.kind());
+                types_dirty_ = false;
+            }
+            return types_;
+        }
+
+        // 是否包含指定类型的消息段
+        bool has(const SegmentType::Kind kind) const {
+            return this->types().has(kind);
+        }
+
+        // 是否包含指定类型的消息段, 如 msg.has<SegmentType::IMAGE>()
+        template <SegmentType::Kind Kind>
+        bool has() const {
+            return this->types().has(Kind);
         }
 
-        // 获取消息段链表的常量引用
-        const std::list<MessageSegment> &segments() const {
+        // 获取消息段序列的引用
+        Segments &segments() {
+            return this->_touch();
+        }
+
+        // 获取消息段序列的常量引用
+        const Segments &segments() const {
             return *this;
         }
 
         // 合并相邻的 text 消息段
         void reduce() {
-            if (this->empty()) {
-                return;
-            }
+            this->_reduce_from(0);
+        }
 
-            auto last_seg_it = this->begin();
-            for (auto it = this->begin(); ++it != this->end();) {
-                if (it->type == "text" && last_seg_it->type == "text" && it->data.find("text") != it->data.end()
-                    && last_seg_it->data.find("text") != last_seg_it->data.end()) {
-                    // found adjacent "text" segments
-                    last_seg_it->data["text"] += it->data["text"];
-                    // remove the current element and continue
-                    this->erase(it);
-                    it = last_seg_it;
-                } else {
-                    last_seg_it = it;
-                }
-            }
+        Message &operator+=(const Message &other) {
+            const auto join = this->size();
+            types_ |= other.types();
+            this->Segments::insert(this->cend(), other.begin(), other.end());
+            this->_reduce_from(join);
+            return *this;
+        }
 
-            if (this->size() == 1 && this->front().type == "text" && this->extract_plain_text().empty()) {
-                this->clear(); // the only item is an empty text segment, we should remove it
+        Message &operator+=(Message &&other) {
+            const auto join = this->size();
+            types_ |= other.types();
+            auto &other_segs = static_cast<Segments &>(other);
+            if (this->empty()) {
+                static_cast<Segments &>(*this) = std::move(other_segs);
+            } else {
+                this->Segments::insert(this->cend(),
+                                       std::make_move_iterator(other_segs.begin()),
+                                       std::make_move_iterator(other_segs.end()));
             }
+            this->_reduce_from(join);
+            return *this;
         }
 
-        Message &operator+=(const Message &other) {
-            this->insert(this->end(), other.begin(), other.end());
-            this->reduce();
+        Message &operator+=(MessageSegment &&seg) {
+            const auto join = this->size();
+            types_.insert(seg.type.kind());
+            this->Segments::push_back(std::move(seg));
+            this->_reduce_from(join);
             return *this;
         }
 
@@ -343,15 +324,182 @@ namespace cq::message {
             return this->operator+=(Message(other));
         }
 
-        Message operator+(const Message &other) const {
+        Message operator+(const Message &other) const & {
             auto result = *this;
             result += other; // use operator+=
             return result;
         }
 
+        Message operator+(Message &&other) const & {
+            auto result = *this;
+            result += std::move(other);
+            return result;
+        }
+
+        Message operator+(const Message &other) && {
+            *this += other;
+            return std::move(*this);
+        }
+
+        Message operator+(Message &&other) && {
+            *this += std::move(other);
+            return std::move(*this);
+        }
+
+        template <typename T>
+        Message operator+(const T &other) const & {
+            return *this + Message(other);
+        }
+
         template <typename T>
-        Message operator+(const T &other) const {
-            return this->operator+(Message(other));
+        Message operator+(const T &other) && {
+            return std::move(*this) + Message(other);
+        }
+
+        // 以下接口可能修改消息段, 调用后 types() 将重新计算
+
+        using Segments::at;
+        using Segments::back;
+        using Segments::begin;
+        using Segments::data;
+        using Segments::end;
+        using Segments::front;
+        using Segments::rbegin;
+        using Segments::rend;
+        using Segments::operator[];
+
+        reference at(const size_type pos) {
+            return this->_touch().at(pos);
+        }
+
+        reference operator[](const size_type pos) {
+            return this->_touch()[pos];
+        }
+
+        reference front() {
+            return this->_touch().front();
+        }
+
+        reference back() {
+            return this->_touch().back();
+        }
+
+        MessageSegment *data() noexcept {
+            return this->_touch().data();
+        }
+
+        iterator begin() noexcept {
+            return this->_touch().begin();
+        }
+
+        iterator end() noexcept {
+            return this->_touch().end();
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return this->_touch().rbegin();
+        }
+
+        reverse_iterator rend() noexcept {
+            return this->_touch().rend();
+        }
+
+        template <typename... Args>
+        void assign(Args &&... args) {
+            this->_touch().assign(std::forward<Args>(args)...);
+        }
+
+        void assign(std::initializer_list<MessageSegment> init) {
+            this->_touch().assign(init);
+        }
+
+        template <typename... Args>
+        iterator insert(Args &&... args) {
+            return this->_touch().insert(std::forward<Args>(args)...);
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<MessageSegment> init) {
+            return this->_touch().insert(pos, init);
+        }
+
+        template <typename... Args>
+        iterator emplace(Args &&... args) {
+            return this->_touch().emplace(std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator erase(Args &&... args) {
+            return this->_touch().erase(std::forward<Args>(args)...);
+        }
+
+        void push_back(const MessageSegment &seg) {
+            this->_touch().push_back(seg);
+        }
+
+        void push_back(MessageSegment &&seg) {
+            this->_touch().push_back(std::move(seg));
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args &&... args) {
+            return this->_touch().emplace_back(std::forward<Args>(args)...);
+        }
+
+        void pop_back() {
+            this->_touch().pop_back();
+        }
+
+        template <typename... Args>
+        void resize(Args &&... args) {
+            this->_touch().resize(std::forward<Args>(args)...);
+        }
+
+        void clear() noexcept {
+            this->_touch().clear();
+        }
+
+        void swap(Message &other) {
+            this->Segments::swap(other);
+            std::swap(types_, other.types_);
+            std::swap(types_dirty_, other.types_dirty_);
+        }
+
+    private:
+        mutable SegmentTypeMask types_;
+        mutable bool types_dirty_ = true;
+
+        // 标记消息段可能被修改, 返回基类引用以便调用其接口
+        Segments &_touch() noexcept {
+            types_dirty_ = true;
+            return *this;
+        }
+
+        // 从下标 first 处的拼接点开始合并相邻的 text 消息段, 假定 first 之前的部分已经合并过,
+        // 因此每次拼接的开销只与新追加的消息段个数有关
+        void _reduce_from(const size_t first) {
+            if (this->empty()) {
+                return;
+            }
+
+            // 原地压缩: last_seg_it 指向已处理部分的最后一个消息段
+            auto &segs = static_cast<Segments &>(*this);
+            auto last_seg_it = segs.begin() + (first > 0 ? std::min(first, segs.size()) - 1 : 0);
+            for (auto it = last_seg_it + 1; it != segs.end(); ++it) {
+                if (it->type == SegmentType::TEXT && last_seg_it->type == SegmentType::TEXT
+                    && it->data.find("text") != it->data.end()
+                    && last_seg_it->data.find("text") != last_seg_it->data.end()) {
+                    // found adjacent "text" segments
+                    last_seg_it->data["text"] += it->data["text"];
+                } else if (++last_seg_it != it) {
+                    *last_seg_it = std::move(*it);
+                }
+            }
+            segs.erase(last_seg_it + 1, segs.end());
+
+            if (segs.size() == 1 && segs.front().type == SegmentType::TEXT && this->extract_plain_text().empty()) {
+                segs.clear(); // the only item is an empty text segment, we should remove it
+                types_ = SegmentTypeMask();
+            }
         }
     };
 
@@ -360,16 +508,192 @@ namespace cq::message {
         return Message(lhs) + rhs;
     }
 
+    template <typename T>
+    inline Message operator+(const T &lhs, Message &&rhs) {
+        return Message(lhs) + std::move(rhs);
+    }
+
     template <typename T>
     inline Message operator+(const MessageSegment &lhs, const T &rhs) {
         return Message(lhs) + rhs;
     }
 
+    // 按字符串形式遍历消息段的游标: 跳过字符串形式为空的消息段, 相邻的纯文本视为一段连续的文本
+    class _CanonicalCursor {
+    public:
+        _CanonicalCursor(const MessageSegment *first, const MessageSegment *last) : it_(first), last_(last) {
+            settle();
+        }
+
+        bool done() const {
+            return it_ == last_;
+        }
+
+        // 当前是否位于纯文本中, 否则位于 CQ 码
+        bool in_text() const {
+            return !text_.empty();
+        }
+
+        // 当前纯文本消息段的剩余部分
+        std::string_view text() const {
+            return text_;
+        }
+
+        const MessageSegment &code() const {
+            return *it_;
+        }
+
+        // 消耗 n 个字符的纯文本, 当前消息段消耗完后前进到下一个
+        void consume_text(const size_t n) {
+            text_.remove_prefix(n);
+            if (text_.empty()) {
+                ++it_;
+                settle();
+            }
+        }
+
+        void next_code() {
+            ++it_;
+            settle();
+        }
+
+    private:
+        const MessageSegment *it_;
+        const MessageSegment *last_;
+        std::string_view text_;
+
+        void settle() {
+            for (; it_ != last_; ++it_) {
+                if (it_->type.empty()) continue;
+                if (it_->type != SegmentType::TEXT) {
+                    text_ = std::string_view();
+                    return;
+                }
+                if (const auto t = it_->data.find("text"); t != it_->data.end() && !t->second.empty()) {
+                    text_ = t->second;
+                    return;
+                }
+            }
+            text_ = std::string_view();
+        }
+    };
+
+    // 逐个比较两个消息段序列, 结果与比较二者的字符串形式相同, 但无需序列化, 且在第一个不同处即返回
+    inline bool _canonical_equal(_CanonicalCursor a, _CanonicalCursor b) {
+        while (!a.done() && !b.done()) {
+            if (a.in_text() != b.in_text()) return false;
+            if (a.in_text()) {
+                const auto n = std::min(a.text().size(), b.text().size());
+                if (a.text().substr(0, n) != b.text().substr(0, n)) return false;
+                a.consume_text(n);
+                b.consume_text(n);
+            } else {
+                if (a.code().type != b.code().type || a.code().data != b.code().data) return false;
+                a.next_code();
+                b.next_code();
+            }
+        }
+        return a.done() && b.done();
+    }
+
+    // 消息段序列字符串形式的 64 位 FNV-1a 哈希, 与 operator== 一致, 且跨平台、跨进程稳定
+    inline uint64_t _canonical_hash(_CanonicalCursor cursor) {
+        uint64_t h = 14695981039346656037ull;
+        const auto feed = [&h](const std::string_view bytes) {
+            for (const auto ch : bytes) {
+                h ^= static_cast<uint8_t>(ch);
+                h *= 1099511628211ull;
+            }
+        };
+        bool in_text = false;
+        while (!cursor.done()) {
+            if (cursor.in_text()) {
+                if (!in_text) feed(std::string_view("\x01", 1)); // 文本开始
+                in_text = true;
+                feed(cursor.text());
+                cursor.consume_text(cursor.text().size());
+            } else {
+                in_text = false;
+                feed(std::string_view("\x02", 1)); // CQ 码开始
+                feed(cursor.code().type.name());
+                for (const auto &item : cursor.code().data) {
+                    feed(std::string_view("\x03", 1));
+                    feed(item.first);
+                    feed(std::string_view("\x04", 1));
+                    feed(item.second);
+                }
+                cursor.next_code();
+            }
+        }
+        return h;
+    }
+
     inline bool operator==(const MessageSegment &lhs, const MessageSegment &rhs) {
-        return std::string(lhs) == std::string(rhs);
+        return _canonical_equal({&lhs, &lhs + 1}, {&rhs, &rhs + 1});
+    }
+
+    inline bool operator!=(const MessageSegment &lhs, const MessageSegment &rhs) {
+        return !(lhs == rhs);
     }
 
     inline bool operator==(const Message &lhs, const Message &rhs) {
-        return std::string(lhs) == std::string(rhs);
+        return _canonical_equal({lhs.data(), lhs.data() + lhs.size()}, {rhs.data(), rhs.data() + rhs.size()});
+    }
+
+    inline bool operator!=(const Message &lhs, const Message &rhs) {
+        return !(lhs == rhs);
+    }
+
+    // 消息段的哈希值, 字符串形式相同的消息段哈希值相同
+    inline uint64_t hash(const MessageSegment &seg) {
+        return _canonical_hash({&seg, &seg + 1});
+    }
+
+    // 消息的哈希值, 字符串形式相同的消息哈希值相同 (如相邻纯文本的拆分方式不同), 可用于复读检测等场景
+    inline uint64_t hash(const Message &msg) {
+        return _canonical_hash({msg.data(), msg.data() + msg.size()});
     }
 } // namespace cq::message
+
+namespace cq {
+    struct MessageEvent::_ParsedMessage {
+        std::string source; // 解析时 message 的内容, 访问时与 message 比较以发现直接赋值等修改
+        message::Message message;
+        std::optional<std::string> plain_text;
+    };
+
+    inline MessageEvent::_ParsedMessage &MessageEvent::_parse() const {
+        // 比较只需一次 memcmp, 相比重新解析可以忽略; 复制的事件修改 message 后各自重新解析, 不影响原事件
+        if (!_parsed || _parsed->source != message) {
+            _parsed =
+                std::make_shared<_ParsedMessage>(_ParsedMessage{message, message::Message(message), std::nullopt});
+        }
+        return *_parsed;
+    }
+
+    inline const message::Message &MessageEvent::parsed_message() const {
+        return _parse().message;
+    }
+
+    inline const std::string &MessageEvent::plain_text() const {
+        auto &parsed = _parse();
+        if (!parsed.plain_text) parsed.plain_text = parsed.message.extract_plain_text();
+        return *parsed.plain_text;
+    }
+} // namespace cq
+
+namespace std {
+    template <>
+    struct hash<cq::message::MessageSegment> {
+        size_t operator()(const cq::message::MessageSegment &seg) const {
+            return static_cast<size_t>(cq::message::hash(seg));
+        }
+    };
+
+    template <>
+    struct hash<cq::message::Message> {
+        size_t operator()(const cq::message::Message &msg) const {
+            return static_cast<size_t>(cq::message::hash(msg));
+        }
+    };
+} // namespace std
@@ -0,0 +1,263 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <charconv>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "escape.hpp"
+
+namespace cq::message {
+    // 格式字符串中占位符 {} 所在的位置, 决定参数的转义方式
+    enum class FormatSlot : uint8_t {
+        TEXT, // 纯文本中, 转义 & [ ]
+        PARAM, // CQ 码参数值中, 额外转义逗号
+    };
+
+    // 仅在格式字符串无效时被调用; 由于格式字符串总是在编译期解析, 调用非 constexpr 函数会使编译失败,
+    // 编译器报错信息中即包含 reason
+    inline void _format_error(const char *reason) {
+        throw std::invalid_argument(reason);
+    }
+
+    // 编译期解析的格式字符串, L 为格式字符串长度
+    template <size_t L>
+    struct _FormatSpec {
+        char literal[L + 1]{}; // 去掉占位符并将 {{ }} 还原后的字面量
+        size_t literal_size = 0;
+        size_t piece_ends[L / 2 + 1]{}; // 第 i 个占位符之前的字面量在 literal 中的结束位置
+        FormatSlot slots[L / 2 + 1]{};
+        size_t slot_count = 0;
+    };
+
+    inline constexpr bool _is_cq_name_char(const char ch) {
+        return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9') || ch == '_'
+               || ch == '-' || ch == '.';
+    }
+
+    // 解析并检查格式字符串: CQ 码必须完整且不能嵌套, 功能名和参数名中不能出现占位符,
+    // 纯文本中不能出现未转义的 [ ], 字面量 { } 写作 {{ }}
+    template <size_t L>
+    constexpr _FormatSpec<L> _parse_format(const std::string_view fmt) {
+        enum State { TEXT, TYPE, KEY, VALUE };
+
+        _FormatSpec<L> spec;
+        auto state = TEXT;
+        size_t name_size = 0; // 当前功能名或参数名的长度
+        for (size_t i = 0; i < fmt.size(); i++) {
+            const auto ch = fmt[i];
+            if (ch == '{' || ch == '}') {
+                if (i + 1 < fmt.size() && fmt[i + 1] == ch) {
+                    if (state == TYPE || state == KEY) _format_error("braces are not allowed in CQ code type or key");
+                    spec.literal[spec.literal_size++] = ch;
+                    i++;
+                    continue;
+                }
+                if (ch == '}' || i + 1 >= fmt.size() || fmt[i + 1] != '}') _format_error("unmatched '{' or '}'");
+                if (state != TEXT && state != VALUE) _format_error("placeholder in CQ code type or key");
+                spec.piece_ends[spec.slot_count] = spec.literal_size;
+                spec.slots[spec.slot_count++] = state == TEXT ? FormatSlot::TEXT : FormatSlot::PARAM;
+                i++;
+                continue;
+            }
+
+            switch (state) {
+            case TEXT:
+                if (ch == ']') _format_error("unescaped ']' in text");
+                if (ch == '[') {
+                    if (fmt.substr(i, 4) != "[CQ:") _format_error("unescaped '[' in text");
+                    for (const auto c : fmt.substr(i, 4)) spec.literal[spec.literal_size++] = c;
+                    i += 3;
+                    state = TYPE;
+                    name_size = 0;
+                    continue;
+                }
+                break;
+            case TYPE:
+            case KEY:
+                if (ch == (state == TYPE ? ',' : '=') || (state == TYPE && ch == ']')) {
+                    if (name_size == 0) _format_error("empty CQ code type or key");
+                    state = ch == ']' ? TEXT : state == TYPE ? KEY : VALUE;
+                    name_size = 0;
+                } else if (_is_cq_name_char(ch)) {
+                    name_size++;
+                } else {
+                    _format_error("invalid character in CQ code type or key");
+                }
+                break;
+            case VALUE:
+                if (ch == '[') _format_error("unescaped '[' in CQ code");
+                if (ch == ',') state = KEY;
+                if (ch == ']') state = TEXT;
+                break;
+            }
+            spec.literal[spec.literal_size++] = ch;
+        }
+        if (state != TEXT) _format_error("unterminated CQ code");
+        return spec;
+    }
+
+    // 格式字符串类型, 即带有静态成员函数 value() 返回格式字符串的类型, 由 CQ_MESSAGE_FORMAT 生成
+    template <typename Fmt, typename = void>
+    struct _is_format : std::false_type {};
+
+    template <typename Fmt>
+    struct _is_format<Fmt, std::void_t<decltype(Fmt::value())>>
+        : std::is_convertible<decltype(Fmt::value()), std::string_view> {};
+
+    template <typename Fmt>
+    inline constexpr _FormatSpec<Fmt::value().size()> _format_spec = _parse_format<Fmt::value().size()>(Fmt::value());
+
+    // 已是 CQ 码形式的字符串, 作为参数时原样插入, 不做转义
+    struct Raw {
+        std::string_view str;
+    };
+
+    inline Raw raw(const std::string_view str) {
+        return {str};
+    }
+
+    // 带有 serialized_size() 和 append_to(std::string &) 的类型 (如 Message, MessageSegment), 原样插入其字符串形式
+    template <typename T, typename = void>
+    struct _is_serializable : std::false_type {};
+
+    template <typename T>
+    struct _is_serializable<
+        T, std::void_t<decltype(std::declval<const T &>().serialized_size()),
+                       decltype(std::declval<const T &>().append_to(std::declval<std::string &>()))>>
+        : std::true_type {};
+
+    // 只能出现在纯文本位置的参数类型
+    template <typename T>
+    inline constexpr bool _is_text_only_arg_v = std::is_same_v<T, Raw> || _is_serializable<T>::value;
+
+    // 类型擦除后的格式化参数, 整数在栈上转换, 字符串不复制
+    class _FormatArg {
+    public:
+        template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+        _FormatArg(const T value) {
+            text_ = std::string_view(buf_, std::to_chars(buf_, buf_ + sizeof(buf_), value).ptr - buf_);
+        }
+
+        _FormatArg(const bool value) : text_(value ? "true" : "false") {
+        }
+
+        template <typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+        _FormatArg(const T value) : owned_(std::to_string(value)) {
+            text_ = owned_;
+        }
+
+        template <typename T, std::enable_if_t<std::is_convertible_v<const T &, std::string_view>, int> = 0>
+        _FormatArg(const T &value) : text_(value), escape_(true) {
+        }
+
+        _FormatArg(const Raw value) : text_(value.str) {
+        }
+
+        template <typename T, std::enable_if_t<_is_serializable<T>::value, int> = 0>
+        _FormatArg(const T &value) : text_(), object_(&value) {
+            size_ = [](const void *obj) { return static_cast<const T *>(obj)->serialized_size(); };
+            append_ = [](const void *obj, std::string &out) { static_cast<const T *>(obj)->append_to(out); };
+        }
+
+        _FormatArg(const _FormatArg &) = delete;
+        _FormatArg &operator=(const _FormatArg &) = delete;
+
+        size_t size(const FormatSlot slot) const {
+            if (object_) return size_(object_);
+            return escape_ ? escaped_size(text_, slot == FormatSlot::PARAM) : text_.size();
+        }
+
+        void append_to(std::string &out, const FormatSlot slot) const {
+            if (object_) {
+                append_(object_, out);
+            } else if (escape_) {
+                escape_to(out, text_, slot == FormatSlot::PARAM);
+            } else {
+                out += text_;
+            }
+        }
+
+    private:
+        std::string_view text_;
+        bool escape_ = false;
+        char buf_[24]; // 足够容纳 64 位整数
+        std::string owned_;
+        const void *object_ = nullptr;
+        size_t (*size_)(const void *) = nullptr;
+        void (*append_)(const void *, std::string &) = nullptr;
+    };
+
+    template <typename Fmt, typename... Args, size_t... I>
+    constexpr bool _format_args_fit(std::index_sequence<I...>) {
+        return ((_format_spec<Fmt>.slots[I] == FormatSlot::TEXT || !_is_text_only_arg_v<Args>) && ...);
+    }
+
+    // 按编译期检查过的格式字符串生成消息, 参数按所在位置转义, 结果一次性分配;
+    // 格式字符串由 CQ_MESSAGE_FORMAT 生成, 如 format(CQ_MESSAGE_FORMAT("[CQ:at,qq={}] {}"), user_id, text)
+    template <typename Fmt, typename... Args, typename = std::enable_if_t<_is_format<Fmt>::value>>
+    inline std::string format(Fmt, const Args &... args) {
+        constexpr auto &spec = _format_spec<Fmt>;
+        static_assert(spec.slot_count == sizeof...(Args), "number of arguments does not match the format string");
+        static_assert(_format_args_fit<Fmt, Args...>(std::index_sequence_for<Args...>()),
+                      "CQ codes and raw strings can only be used outside CQ codes");
+
+        std::string out;
+        if constexpr (sizeof...(Args) == 0) {
+            out.assign(spec.literal, spec.literal_size);
+        } else {
+            const _FormatArg fargs[] = {_FormatArg(args)...};
+            auto size = spec.literal_size;
+            for (size_t i = 0; i < sizeof...(Args); i++) size += fargs[i].size(spec.slots[i]);
+            out.reserve(size);
+
+            size_t pos = 0;
+            for (size_t i = 0; i < sizeof...(Args); i++) {
+                out.append(spec.literal + pos, spec.piece_ends[i] - pos);
+                pos = spec.piece_ends[i];
+                fargs[i].append_to(out, spec.slots[i]);
+            }
+            out.append(spec.literal + pos, spec.literal_size - pos);
+        }
+        return out;
+    }
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    // 可作为模板参数的字符串字面量 (C++20)
+    template <size_t N>
+    struct FormatLiteral {
+        char chars[N]{};
+
+        constexpr FormatLiteral(const char (&str)[N]) {
+            for (size_t i = 0; i < N; i++) chars[i] = str[i];
+        }
+    };
+
+    template <FormatLiteral Literal>
+    struct _LiteralFormat {
+        static constexpr std::string_view value() {
+            return std::string_view(Literal.chars, sizeof(Literal.chars) - 1);
+        }
+    };
+
+    // C++20 下可直接写作 format<"[CQ:at,qq={}] {}">(user_id, text)
+    template <FormatLiteral Literal, typename... Args>
+    inline std::string format(const Args &... args) {
+        return format(_LiteralFormat<Literal>(), args...);
+    }
+#endif
+} // namespace cq::message
+
+// 生成编译期检查的格式字符串, 供 cq::message::format 使用
+#define CQ_MESSAGE_FORMAT(Str)                             \
+    [] {                                                   \
+        struct _Format {                                   \
+            static constexpr std::string_view value() {    \
+                return Str;                                \
+            }                                              \
+        };                                                 \
+        return _Format();                                  \
+    }()
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <iterator>
+#include <string_view>
+
+#include "escape.hpp"
+#include "message_view.hpp"
+
+#include "../utils/gb18030.hpp"
+#include "../utils/unicode.hpp"
+
+namespace cq::message {
+    // msg 中 pos 处的一个 UTF-8 字符在 GB18030 编码下的字节数, 并设置 len 为其 UTF-8 字节数;
+    // 与 utils::utf8_to_gb18030_to 一致, 非法字节按 1 字节 ('?') 计
+    inline size_t _gb18030_char_size(const std::string_view msg, const size_t pos, size_t &len) {
+        const auto lead = static_cast<unsigned char>(msg[pos]);
+        if (lead < 0x80) {
+            len = 1;
+            return 1;
+        }
+        const auto cp = utils::_decode_utf8(reinterpret_cast<const uint8_t *>(msg.data() + pos), msg.size() - pos, len);
+        return cp == utils::REPLACEMENT_CHARACTER && len == 1 ? 1 : utils::gb18030_code_point_size(cp);
+    }
+
+    // 从 pos 处切出一块不超过 max_bytes (GB18030 编码) 的消息, 返回其结束位置;
+    // CQ 码、转义实体和 UTF-8 字符不会被切开, 块的后半部分有换行时在最后一个换行之后切分;
+    // 单个 CQ 码超过 max_bytes 时独占一块
+    inline size_t _split_chunk(const std::string_view msg, const size_t pos, const size_t max_bytes) {
+        const auto n = msg.size();
+        size_t used = 0;
+        size_t end = pos;
+        size_t newline_end = pos; // 最后一个换行之后的位置
+        const auto cut = [&] {
+            // 优先在换行处切分, 但不让当前块短于一半
+            return newline_end > pos && newline_end - pos >= (end - pos) / 2 ? newline_end : end;
+        };
+
+        MessageSegmentView seg;
+        while (end < n) {
+            const auto next = _scan_segment(msg, end, seg);
+            if (seg.is_code) {
+                const auto cost = utils::gb18030_size(seg.raw);
+                if (used + cost > max_bytes && end > pos) return cut();
+                used += cost;
+                end = next;
+                continue;
+            }
+            while (end < next) {
+                size_t len, cost;
+                if (msg[end] == '&' && _unescape_entity(msg.substr(end)) != '\0') {
+                    len = cost = 5;
+                } else {
+                    cost = _gb18030_char_size(msg.substr(0, next), end, len);
+                }
+                if (used + cost > max_bytes && end > pos) return cut();
+                used += cost;
+                end += len;
+                if (msg[end - 1] == '\n') newline_end = end;
+            }
+        }
+        return n;
+    }
+
+    // 将字符串形式的消息按 GB18030 编码后的字节数切分为多块, 用于发送超长消息;
+    // 切分是惰性的, 每块都是指向原始字符串的视图, 不复制消息内容, 所有块按顺序拼接即为原消息.
+    // 每个字符按其实际的 GB18030 编码长度计算, 块在下一个字符放不下时才结束
+    class MessageSplitter {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const std::string_view *;
+            using reference = const std::string_view &;
+
+            iterator() = default;
+
+            iterator(const std::string_view msg, const size_t pos, const size_t max_bytes)
+                : msg_(msg), max_bytes_(max_bytes) {
+                seek(pos);
+            }
+
+            reference operator*() const {
+                return chunk_;
+            }
+
+            pointer operator->() const {
+                return &chunk_;
+            }
+
+            iterator &operator++() {
+                seek(pos_ + chunk_.size());
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator &other) const {
+                return pos_ == other.pos_;
+            }
+
+            bool operator!=(const iterator &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            std::string_view msg_;
+            size_t max_bytes_ = 0;
+            size_t pos_ = 0;
+            std::string_view chunk_;
+
+            void seek(const size_t pos) {
+                pos_ = pos;
+                chunk_ = msg_.substr(pos, _split_chunk(msg_, pos, max_bytes_) - pos);
+            }
+        };
+
+        MessageSplitter(const std::string_view msg, const size_t max_bytes) : msg_(msg), max_bytes_(max_bytes) {
+        }
+
+        iterator begin() const {
+            return iterator(msg_, 0, max_bytes_);
+        }
+
+        iterator end() const {
+            return iterator(msg_, msg_.size(), max_bytes_);
+        }
+
+    private:
+        std::string_view msg_;
+        size_t max_bytes_;
+    };
+
+    // 切分字符串形式的消息, 如 for (auto chunk : split(msg, 4000)) send_message(target, std::string(chunk));
+    inline MessageSplitter split(const std::string_view msg, const size_t max_bytes) {
+        return MessageSplitter(msg, max_bytes);
+    }
+} // namespace cq::message
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <charconv>
+#include <initializer_list>
+#include <type_traits>
+#include <variant>
+
+#include "message.hpp"
+
+namespace cq::message {
+    // 纯文本
+    struct TextSegment {
+        std::string text;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::text(text);
+        }
+    };
+
+    // @某人
+    struct AtSegment {
+        int64_t user_id;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::at(user_id);
+        }
+    };
+
+    // QQ 表情
+    struct FaceSegment {
+        int id;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::face(id);
+        }
+    };
+
+    // Emoji 表情
+    struct EmojiSegment {
+        uint32_t id;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::emoji(id);
+        }
+    };
+
+    // 图片
+    struct ImageSegment {
+        std::string file;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::image(file);
+        }
+    };
+
+    // 语音
+    struct RecordSegment {
+        std::string file;
+        bool magic;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::record(file, magic);
+        }
+    };
+
+    // 猜拳魔法表情
+    struct RpsSegment {
+        MessageSegment to_segment() const {
+            return MessageSegment::rps();
+        }
+    };
+
+    // 掷骰子魔法表情
+    struct DiceSegment {
+        MessageSegment to_segment() const {
+            return MessageSegment::dice();
+        }
+    };
+
+    // 戳一戳
+    struct ShakeSegment {
+        MessageSegment to_segment() const {
+            return MessageSegment::shake();
+        }
+    };
+
+    // 链接分享
+    struct ShareSegment {
+        std::string url;
+        std::string title;
+        std::string content;
+        std::string image_url;
+
+        MessageSegment to_segment() const {
+            return MessageSegment::share(url, title, content, image_url);
+        }
+    };
+
+    // 带类型的消息段, 已知类型的字段已解码 (如 AtSegment::user_id 为整数);
+    // 无法无损表示为已知类型的消息段 (如带有额外参数、数字不规范) 保留为通用的 MessageSegment
+    using TypedSegment = std::variant<TextSegment,
+                                      AtSegment,
+                                      FaceSegment,
+                                      EmojiSegment,
+                                      ImageSegment,
+                                      RecordSegment,
+                                      RpsSegment,
+                                      DiceSegment,
+                                      ShakeSegment,
+                                      ShareSegment,
+                                      MessageSegment>;
+
+    // 带类型的消息
+    using TypedMessage = utils::SmallVector<TypedSegment, 4>;
+
+    // 消息段数据是否恰好包含给定的参数
+    inline bool _has_exactly(const MessageSegment::Data &data, const std::initializer_list<std::string_view> keys) {
+        if (data.size() != keys.size()) return false;
+        for (const auto key : keys) {
+            if (!data.contains(key)) return false;
+        }
+        return true;
+    }
+
+    // 解析整数, 仅接受转换回字符串后与原文相同的形式, 以保证无损
+    template <typename T>
+    inline bool _parse_canonical(const std::string_view str, T &value) {
+        const auto end = str.data() + str.size();
+        const auto res = std::from_chars(str.data(), end, value);
+        if (res.ec != std::errc() || res.ptr != end) return false;
+        char buf[24];
+        return std::string_view(buf, std::to_chars(buf, buf + sizeof(buf), value).ptr - buf) == str;
+    }
+
+    inline bool _parse_canonical(const std::string_view str, bool &value) {
+        if (str != "true" && str != "false") return false;
+        value = str == "true";
+        return true;
+    }
+
+    template <typename Seg>
+    inline TypedSegment _to_typed(Seg &&seg) {
+        const auto &data = seg.data;
+        // 取出字符串参数, 右值参数时直接移动
+        const auto take = [&seg](const std::string_view key) -> std::string {
+            if constexpr (std::is_const_v<std::remove_reference_t<Seg>>) {
+                return seg.data.find(key)->second;
+            } else {
+                return std::move(seg.data.find(key)->second);
+            }
+        };
+
+        switch (seg.type.kind()) {
+        case SegmentType::TEXT:
+            if (_has_exactly(data, {"text"})) return TextSegment{take("text")};
+            break;
+        case SegmentType::AT:
+            if (AtSegment at; _has_exactly(data, {"qq"}) && _parse_canonical(data.at("qq"), at.user_id)) return at;
+            break;
+        case SegmentType::FACE:
+            if (FaceSegment face; _has_exactly(data, {"id"}) && _parse_canonical(data.at("id"), face.id)) {
+                return face;
+            }
+            break;
+        case SegmentType::EMOJI:
+            if (EmojiSegment emoji; _has_exactly(data, {"id"}) && _parse_canonical(data.at("id"), emoji.id)) {
+                return emoji;
+            }
+            break;
+        case SegmentType::IMAGE:
+            if (_has_exactly(data, {"file"})) return ImageSegment{take("file")};
+            break;
+        case SegmentType::RECORD:
+            if (bool magic; _has_exactly(data, {"file", "magic"}) && _parse_canonical(data.at("magic"), magic)) {
+                return RecordSegment{take("file"), magic};
+            }
+            break;
+        case SegmentType::RPS:
+            if (data.empty()) return RpsSegment{};
+            break;
+        case SegmentType::DICE:
+            if (data.empty()) return DiceSegment{};
+            break;
+        case SegmentType::SHAKE:
+            if (data.empty()) return ShakeSegment{};
+            break;
+        case SegmentType::SHARE:
+            if (_has_exactly(data, {"url", "title", "content", "image"})) {
+                return ShareSegment{take("url"), take("title"), take("content"), take("image")};
+            }
+            break;
+        default:
+            break;
+        }
+        return std::forward<Seg>(seg);
+    }
+
+    // 将消息段转换为带类型的消息段
+    inline TypedSegment to_typed(const MessageSegment &seg) {
+        return _to_typed(seg);
+    }
+
+    inline TypedSegment to_typed(MessageSegment &&seg) {
+        return _to_typed(std::move(seg));
+    }
+
+    // 将消息转换为带类型的消息
+    inline TypedMessage to_typed(const Message &msg) {
+        TypedMessage typed;
+        typed.reserve(msg.size());
+        for (const auto &seg : msg) typed.push_back(to_typed(seg));
+        return typed;
+    }
+
+    // 将带类型的消息段转换回通用的消息段, 与转换前相等
+    inline MessageSegment to_segment(const TypedSegment &typed) {
+        return std::visit(
+            [](const auto &seg) -> MessageSegment {
+                if constexpr (std::is_same_v<std::decay_t<decltype(seg)>, MessageSegment>) {
+                    return seg;
+                } else {
+                    return seg.to_segment();
+                }
+            },
+            typed);
+    }
+
+    // 将带类型的消息转换回通用的消息
+    inline Message to_message(const TypedMessage &typed) {
+        Message msg;
+        msg.reserve(typed.size());
+        for (const auto &seg : typed) msg.push_back(to_segment(seg));
+        return msg;
+    }
+} // namespace cq::message
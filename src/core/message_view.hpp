@@ -0,0 +1,302 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "segment_type.hpp"
+
+namespace cq::message {
+    inline bool _is_space(const char ch) {
+        return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' || ch == '\r';
+    }
+
+    inline std::string_view _trim(std::string_view sv) {
+        while (!sv.empty() && _is_space(sv.front())) sv.remove_prefix(1);
+        while (!sv.empty() && _is_space(sv.back())) sv.remove_suffix(1);
+        return sv;
+    }
+
+    // CQ 码参数视图, 如 file=abc.jpg, 参数值仍为 CQ 码转义形式
+    struct ParamView {
+        std::string_view key;
+        std::string_view value;
+    };
+
+    // CQ 码参数列表 (如 file=abc.jpg,magic=false) 的惰性视图, 遍历时才逐个切分参数
+    class ParamsView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ParamView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ParamView *;
+            using reference = const ParamView &;
+
+            iterator() = default;
+
+            explicit iterator(std::string_view rest) : rest_(rest), done_(false) {
+                advance();
+            }
+
+            reference operator*() const {
+                return param_;
+            }
+
+            pointer operator->() const {
+                return &param_;
+            }
+
+            iterator &operator++() {
+                advance();
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto tmp = *this;
+                advance();
+                return tmp;
+            }
+
+            bool operator==(const iterator &other) const {
+                return done_ == other.done_ && (done_ || rest_.data() == other.rest_.data());
+            }
+
+            bool operator!=(const iterator &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            std::string_view rest_;
+            ParamView param_;
+            bool done_ = true;
+
+            void advance() {
+                while (rest_.data() != nullptr) {
+                    const auto comma_pos = rest_.find(',');
+                    const auto param = _trim(rest_.substr(0, comma_pos));
+                    if (comma_pos == std::string_view::npos) {
+                        rest_ = std::string_view();
+                    } else {
+                        rest_.remove_prefix(comma_pos + 1);
+                    }
+                    if (param.empty()) continue;
+
+                    const auto eq_pos = param.find('=');
+                    param_.key = param.substr(0, eq_pos);
+                    param_.value = eq_pos != std::string_view::npos ? param.substr(eq_pos + 1) : std::string_view();
+                    return;
+                }
+                done_ = true;
+            }
+        };
+
+        ParamsView() = default;
+
+        explicit ParamsView(std::string_view raw) : raw_(raw) {
+        }
+
+        iterator begin() const {
+            return raw_.data() ? iterator(raw_) : iterator();
+        }
+
+        iterator end() const {
+            return iterator();
+        }
+
+        bool empty() const {
+            return begin() == end();
+        }
+
+        // 获取指定参数的值 (重复出现时取第一个), 不存在时返回 std::nullopt
+        std::optional<std::string_view> get(const std::string_view key) const {
+            for (const auto &param : *this) {
+                if (param.key == key) return param.value;
+            }
+            return std::nullopt;
+        }
+
+        // 未切分的原始参数列表
+        std::string_view raw() const {
+            return raw_;
+        }
+
+    private:
+        std::string_view raw_;
+    };
+
+    // 消息段视图, 所有字段均指向原始消息字符串, 不持有数据
+    struct MessageSegmentView {
+        bool is_code = false; // 是否为 CQ 码形式, 否则为纯文本
+        std::string_view type; // 消息段类型, 纯文本为 "text"
+        std::string_view text; // 纯文本内容 (仍为 CQ 码转义形式), 仅纯文本形式的消息段有效
+        ParamsView params; // CQ 码参数, 仅 CQ 码形式的消息段有效
+        std::string_view raw; // 消息段在原始消息中对应的部分
+    };
+
+    // 从 pos 处扫描一个消息段, 结果写入 seg, 返回下一个消息段的起始位置;
+    // 相邻的纯文本 (包括不完整的 CQ 码) 总是合并为同一个消息段
+    inline size_t _scan_segment(const std::string_view msg, const size_t pos, MessageSegmentView &seg) {
+        static constexpr std::string_view CQ_BEGIN = "[CQ:";
+        static constexpr std::string_view TEXT_TYPE = "text";
+
+        const auto n = msg.size();
+        if (pos >= n) return n;
+
+        auto search = pos;
+        size_t close = 0; // 缓存的下一个 ']' 位置, 避免重复查找
+        while (true) {
+            const auto begin = msg.find(CQ_BEGIN, search);
+            if (begin == std::string_view::npos) break; // 剩余部分均为纯文本
+
+            const auto content_begin = begin + CQ_BEGIN.size();
+            if (close < content_begin) close = msg.find(']', content_begin);
+            if (close == std::string_view::npos) break; // 之后不再有 ']', 剩余部分均为纯文本
+
+            const auto content = msg.substr(content_begin, close - content_begin);
+            if (const auto next_begin = content.find(CQ_BEGIN); next_begin != std::string_view::npos) {
+                // CQ 码未结束就遇到了下一个 CQ 码开头, 前面的部分作为纯文本
+                search = content_begin + next_begin;
+                continue;
+            }
+
+            if (begin > pos) {
+                // 先返回 CQ 码之前的纯文本
+                seg = MessageSegmentView{false, TEXT_TYPE, msg.substr(pos, begin - pos), ParamsView(), {}};
+                seg.raw = seg.text;
+                return begin;
+            }
+
+            const auto comma_pos = content.find(',');
+            seg.is_code = true;
+            seg.type = content.substr(0, comma_pos);
+            seg.text = std::string_view();
+            seg.params = comma_pos != std::string_view::npos ? ParamsView(content.substr(comma_pos + 1)) : ParamsView();
+            seg.raw = msg.substr(begin, close + 1 - begin);
+            return close + 1;
+        }
+
+        seg = MessageSegmentView{false, TEXT_TYPE, msg.substr(pos), ParamsView(), {}};
+        seg.raw = seg.text;
+        return n;
+    }
+
+    // 调用回调函数, 返回 false 表示停止扫描, 回调无返回值时总是继续
+    template <typename F, typename... Args>
+    inline bool _invoke_continue(F &&func, Args &&... args) {
+        if constexpr (std::is_void_v<std::invoke_result_t<F, Args...>>) {
+            std::invoke(std::forward<F>(func), std::forward<Args>(args)...);
+            return true;
+        } else {
+            return static_cast<bool>(std::invoke(std::forward<F>(func), std::forward<Args>(args)...));
+        }
+    }
+
+    // 流式扫描字符串形式的消息, 对纯文本调用 on_text(std::string_view text) (仍为转义形式),
+    // 对 CQ 码调用 on_code(std::string_view type, const ParamsView &params), 不做任何内存分配;
+    // 回调返回 false 时立即停止扫描, 返回值表示是否扫描了整个消息
+    template <typename OnText, typename OnCode>
+    inline bool scan(const std::string_view msg, OnText &&on_text, OnCode &&on_code) {
+        MessageSegmentView seg;
+        for (size_t pos = 0; pos < msg.size();) {
+            pos = _scan_segment(msg, pos, seg);
+            const auto go_on = seg.is_code ? _invoke_continue(on_code, seg.type, std::as_const(seg.params))
+                                           : _invoke_continue(on_text, seg.text);
+            if (!go_on) return false;
+        }
+        return true;
+    }
+
+    // 字符串形式消息的只读视图, 遍历时单趟扫描原始字符串, 不做任何内存分配;
+    // 视图不持有消息字符串, 使用期间需保证其有效
+    class MessageView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = MessageSegmentView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const MessageSegmentView *;
+            using reference = const MessageSegmentView &;
+
+            iterator() = default;
+
+            iterator(std::string_view msg, size_t pos) : msg_(msg), pos_(pos) {
+                next_ = _scan_segment(msg_, pos_, seg_);
+            }
+
+            reference operator*() const {
+                return seg_;
+            }
+
+            pointer operator->() const {
+                return &seg_;
+            }
+
+            iterator &operator++() {
+                pos_ = next_;
+                next_ = _scan_segment(msg_, pos_, seg_);
+                return *this;
+            }
+
+            iterator operator++(int) {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator &other) const {
+                return pos_ == other.pos_;
+            }
+
+            bool operator!=(const iterator &other) const {
+                return !(*this == other);
+            }
+
+        private:
+            std::string_view msg_;
+            size_t pos_ = 0;
+            size_t next_ = 0;
+            MessageSegmentView seg_;
+        };
+
+        MessageView() = default;
+
+        explicit MessageView(std::string_view msg) : msg_(msg) {
+        }
+
+        iterator begin() const {
+            return iterator(msg_, 0);
+        }
+
+        iterator end() const {
+            return iterator(msg_, msg_.size());
+        }
+
+        bool empty() const {
+            return msg_.empty();
+        }
+
+        // 原始消息字符串
+        std::string_view raw() const {
+            return msg_;
+        }
+
+        // 消息中出现的消息段类型, 每次调用都扫描整个消息
+        SegmentTypeMask types() const {
+            SegmentTypeMask mask;
+            for (const auto &seg : *this) {
+                mask.insert(seg.is_code ? SegmentType::lookup(seg.type) : SegmentType::TEXT);
+            }
+            return mask;
+        }
+
+    private:
+        std::string_view msg_;
+    };
+} // namespace cq::message
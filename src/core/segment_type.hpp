@@ -0,0 +1,288 @@
+#pragma once
+
+#include "common.hpp"
+
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+
+namespace cq::message {
+    // 消息段类型 (即 CQ 码的功能名), 已知类型以整数枚举表示, 比较时无需字符串比较; 未知类型额外保存其名称
+    class SegmentType {
+    public:
+        enum Kind : uint8_t {
+            NONE, // 空类型
+            TEXT, // 纯文本
+            FACE, // QQ 表情
+            EMOJI, // Emoji 表情
+            BFACE, // 原创表情
+            SFACE, // 小表情
+            IMAGE, // 图片
+            RECORD, // 语音
+            AT, // @某人
+            RPS, // 猜拳魔法表情
+            DICE, // 掷骰子魔法表情
+            SHAKE, // 戳一戳
+            ANONYMOUS, // 匿名发消息
+            SHARE, // 链接分享
+            CONTACT, // 推荐好友, 推荐群
+            LOCATION, // 位置
+            MUSIC, // 音乐
+            SHOW, // 厘米秀
+            SIGN, // 签到
+            RICH, // 富文本
+            HB, // 红包
+            CUSTOM, // 未知类型
+        };
+
+        static constexpr size_t KIND_COUNT = CUSTOM + 1;
+
+        // 查找名称对应的已知类型, 空名称返回 NONE, 未知名称返回 CUSTOM
+        static Kind lookup(const std::string_view name) noexcept {
+            if (name.empty()) return NONE;
+            for (uint8_t kind = TEXT; kind < CUSTOM; kind++) {
+                if (_names()[kind].compare(name) == 0) return static_cast<Kind>(kind);
+            }
+            return CUSTOM;
+        }
+
+        // 已知类型的名称, CUSTOM 返回空字符串
+        static std::string_view name_of(const Kind kind) noexcept {
+            return kind < CUSTOM ? _names()[kind] : std::string_view();
+        }
+
+        SegmentType() noexcept = default;
+
+        // 从已知类型构造, kind 不应为 CUSTOM
+        SegmentType(const Kind kind) noexcept : kind_(kind) {
+        }
+
+        SegmentType(const std::string_view name) : kind_(lookup(name)) {
+            if (kind_ == CUSTOM) custom_ = std::make_unique<std::string>(name);
+        }
+
+        SegmentType(const char *name) : SegmentType(std::string_view(name)) {
+        }
+
+        SegmentType(const std::string &name) : SegmentType(std::string_view(name)) {
+        }
+
+        SegmentType(std::string &&name) : kind_(lookup(name)) {
+            if (kind_ == CUSTOM) custom_ = std::make_unique<std::string>(std::move(name));
+        }
+
+        SegmentType(const SegmentType &other)
+            : kind_(other.kind_), custom_(other.custom_ ? std::make_unique<std::string>(*other.custom_) : nullptr) {
+        }
+
+        SegmentType(SegmentType &&other) noexcept = default;
+
+        SegmentType &operator=(const SegmentType &other) {
+            if (this != &other) {
+                kind_ = other.kind_;
+                custom_ = other.custom_ ? std::make_unique<std::string>(*other.custom_) : nullptr;
+            }
+            return *this;
+        }
+
+        SegmentType &operator=(SegmentType &&other) noexcept = default;
+
+        Kind kind() const noexcept {
+            return kind_;
+        }
+
+        std::string_view name() const noexcept {
+            return custom_ ? std::string_view(*custom_) : name_of(kind_);
+        }
+
+        bool empty() const noexcept {
+            return kind_ == NONE;
+        }
+
+        operator std::string() const {
+            return std::string(name());
+        }
+
+        friend bool operator==(const SegmentType &lhs, const SegmentType &rhs) {
+            return lhs.kind() == rhs.kind() && (lhs.kind() != CUSTOM || lhs.name().compare(rhs.name()) == 0);
+        }
+
+        friend bool operator!=(const SegmentType &lhs, const SegmentType &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const SegmentType &lhs, const SegmentType &rhs) {
+            return lhs.name().compare(rhs.name()) < 0;
+        }
+
+        friend bool operator==(const SegmentType &lhs, const Kind rhs) {
+            return lhs.kind() == rhs;
+        }
+
+        friend bool operator!=(const SegmentType &lhs, const Kind rhs) {
+            return lhs.kind() != rhs;
+        }
+
+        friend bool operator==(const SegmentType &lhs, const std::string_view rhs) {
+            return lhs.name().compare(rhs) == 0;
+        }
+
+        friend bool operator!=(const SegmentType &lhs, const std::string_view rhs) {
+            return lhs.name().compare(rhs) != 0;
+        }
+
+        friend bool operator==(const SegmentType &lhs, const std::string &rhs) {
+            return lhs.name().compare(rhs) == 0;
+        }
+
+        friend bool operator!=(const SegmentType &lhs, const std::string &rhs) {
+            return lhs.name().compare(rhs) != 0;
+        }
+
+        friend bool operator==(const SegmentType &lhs, const char *rhs) {
+            return lhs.name().compare(rhs) == 0;
+        }
+
+        friend bool operator!=(const SegmentType &lhs, const char *rhs) {
+            return lhs.name().compare(rhs) != 0;
+        }
+
+        friend bool operator==(const Kind lhs, const SegmentType &rhs) {
+            return rhs == lhs;
+        }
+
+        friend bool operator!=(const Kind lhs, const SegmentType &rhs) {
+            return rhs != lhs;
+        }
+
+        friend bool operator==(const std::string &lhs, const SegmentType &rhs) {
+            return rhs == lhs;
+        }
+
+        friend bool operator!=(const std::string &lhs, const SegmentType &rhs) {
+            return rhs != lhs;
+        }
+
+        friend bool operator==(const char *lhs, const SegmentType &rhs) {
+            return rhs == lhs;
+        }
+
+        friend bool operator!=(const char *lhs, const SegmentType &rhs) {
+            return rhs != lhs;
+        }
+
+        friend std::string operator+(const std::string &lhs, const SegmentType &rhs) {
+            return lhs + std::string(rhs.name());
+        }
+
+        friend std::string operator+(const char *lhs, const SegmentType &rhs) {
+            return lhs + std::string(rhs.name());
+        }
+
+        friend std::string operator+(const SegmentType &lhs, const std::string &rhs) {
+            return std::string(lhs.name()) + rhs;
+        }
+
+        friend std::string operator+(const SegmentType &lhs, const char *rhs) {
+            return std::string(lhs.name()) + rhs;
+        }
+
+    private:
+        Kind kind_ = NONE;
+        std::unique_ptr<std::string> custom_; // 仅 CUSTOM 类型非空
+
+        static const std::string_view *_names() noexcept {
+            static constexpr std::string_view names[KIND_COUNT] = {
+                "",
+                "text",
+                "face",
+                "emoji",
+                "bface",
+                "sface",
+                "image",
+                "record",
+                "at",
+                "rps",
+                "dice",
+                "shake",
+                "anonymous",
+                "share",
+                "contact",
+                "location",
+                "music",
+                "show",
+                "sign",
+                "rich",
+                "hb",
+                "",
+            };
+            return names;
+        }
+    };
+
+    static_assert(SegmentType::KIND_COUNT <= 32, "SegmentTypeMask cannot hold all segment kinds");
+
+    // 消息段类型的集合, 以位掩码表示, 查询和合并均为 O(1)
+    class SegmentTypeMask {
+    public:
+        constexpr SegmentTypeMask() noexcept = default;
+
+        constexpr SegmentTypeMask(const SegmentType::Kind kind) noexcept : bits_(uint32_t(1) << kind) {
+        }
+
+        constexpr SegmentTypeMask(const std::initializer_list<SegmentType::Kind> kinds) noexcept {
+            for (const auto kind : kinds) insert(kind);
+        }
+
+        constexpr void insert(const SegmentType::Kind kind) noexcept {
+            bits_ |= uint32_t(1) << kind;
+        }
+
+        constexpr bool has(const SegmentType::Kind kind) const noexcept {
+            return (bits_ & (uint32_t(1) << kind)) != 0;
+        }
+
+        // 是否包含 other 中的任意一种类型
+        constexpr bool has_any(const SegmentTypeMask other) const noexcept {
+            return (bits_ & other.bits_) != 0;
+        }
+
+        // 是否包含 other 中的全部类型
+        constexpr bool has_all(const SegmentTypeMask other) const noexcept {
+            return (bits_ & other.bits_) == other.bits_;
+        }
+
+        constexpr bool empty() const noexcept {
+            return bits_ == 0;
+        }
+
+        constexpr uint32_t bits() const noexcept {
+            return bits_;
+        }
+
+        constexpr SegmentTypeMask &operator|=(const SegmentTypeMask other) noexcept {
+            bits_ |= other.bits_;
+            return *this;
+        }
+
+        friend constexpr SegmentTypeMask operator|(SegmentTypeMask lhs, const SegmentTypeMask rhs) noexcept {
+            return lhs |= rhs;
+        }
+
+        friend constexpr SegmentTypeMask operator&(SegmentTypeMask lhs, const SegmentTypeMask rhs) noexcept {
+            lhs.bits_ &= rhs.bits_;
+            return lhs;
+        }
+
+        friend constexpr bool operator==(const SegmentTypeMask lhs, const SegmentTypeMask rhs) noexcept {
+            return lhs.bits_ == rhs.bits_;
+        }
+
+        friend constexpr bool operator!=(const SegmentTypeMask lhs, const SegmentTypeMask rhs) noexcept {
+            return lhs.bits_ != rhs.bits_;
+        }
+
+    private:
+        uint32_t bits_ = 0;
+    };
+} // namespace cq::message
@@ -2,10 +2,14 @@
 
 #include "common.hpp"
 
+#include <future>
+#include <thread>
+
 #include "exception.hpp"
 
 #include "../utils/base64.hpp"
 #include "../utils/binpack.hpp"
+#include "../utils/binschema.hpp"
 
 namespace cq {
     class ObjectHelper {
@@ -13,18 +17,66 @@ namespace cq {
         // 从 Base64 字符串解析数据对象,
         // 注意, 与 T::from_bytes 不同, 后者从二进制数据中提取对象
         template <typename T>
-        static T from_base64(const std::string &b64) noexcept(false) {
-            return T::from_bytes(utils::base64_decode(b64));
+        static T from_base64(const std::string_view b64) noexcept(false) {
+            return T::from_bytes(_decode_base64(b64));
         }
 
-        // 从 Base64 字符串解析数据对象集合
+        // 从 Base64 字符串解析数据对象, 失败时返回 std::nullopt 而不抛出异常
+        template <typename T>
+        static std::optional<T> try_from_base64(const std::string_view b64) {
+            return T::try_from_bytes(_decode_base64(b64));
+        }
+
+        // 将数据对象编码为酷Q格式的二进制数据, 格式由 T::Schema 描述
+        template <typename T>
+        static std::string to_bytes(const T &obj) {
+            return T::Schema::encode(obj);
+        }
+
+        // 将数据对象编码为 Base64 字符串, 可由 from_base64 解析
+        template <typename T>
+        static std::string to_base64(const T &obj) {
+            return _encode_base64(to_bytes(obj));
+        }
+
+        // 将数据对象集合编码为 Base64 字符串, 可由 multi_from_base64 解析
+        template <typename Container>
+        static std::string multi_to_base64(const Container &objs) {
+            using T = typename Container::value_type;
+            std::string bytes;
+            utils::_append_big_endian(bytes, static_cast<int32_t>(std::size(objs)));
+            std::string record;
+            for (const auto &obj : objs) {
+                record.clear();
+                T::Schema::encode_to(record, obj);
+                utils::_append_big_endian(bytes, static_cast<int16_t>(record.size()));
+                bytes += record;
+            }
+            return _encode_base64(bytes);
+        }
+
+        // 从 Base64 字符串解析数据对象集合;
+        // 记录数不少于 PARALLEL_DECODE_MIN_COUNT 时, 先索引出各条记录, 再分段在多个线程中解析
         template <typename Container>
-        static Container multi_from_base64(const std::string &b64) noexcept(false) {
+        static Container multi_from_base64(const std::string_view b64) noexcept(false) {
             Container result;
             auto inserter = std::back_inserter(result);
-            auto pack = utils::BinPack(utils::base64_decode(b64));
+            auto pack = utils::BinPackView(_decode_base64(b64));
             try {
                 const auto count = pack.pop_int<int32_t>();
+                if (count >= static_cast<int32_t>(PARALLEL_DECODE_MIN_COUNT)) {
+                    // 每条记录至少有 2 字节的长度前缀, 不按不可信的 count 预留过多空间
+                    std::vector<std::string_view> tokens;
+                    tokens.reserve(std::min(static_cast<size_t>(count), pack.size() / 2));
+                    for (auto i = 0; i < count; i++) {
+                        tokens.push_back(pack.pop_token());
+                    }
+                    _parallel_from_tokens(result, tokens);
+                    return result;
+                }
+                if constexpr (_has_reserve<Container>::value) {
+                    if (count > 0) result.reserve(static_cast<size_t>(count));
+                }
                 for (auto i = 0; i < count; i++) {
                     *inserter = Container::value_type::from_bytes(pack.pop_token());
                 }
@@ -33,6 +85,76 @@ namespace cq {
             }
             return result;
         }
+
+    private:
+        // 解码到当前线程复用的缓冲区, 返回的视图在下次调用前有效;
+        // 各对象的 from_bytes 直接在缓冲区上解析, 整个过程只有这一份解码数据
+        static std::string_view _decode_base64(const std::string_view b64) {
+            thread_local std::string buffer;
+            if (buffer.capacity() > DECODE_BUFFER_MAX_CAPACITY) std::string().swap(buffer);
+            buffer.clear();
+            utils::base64_decode_to(buffer, b64);
+            return buffer;
+        }
+
+        // 超过此容量的解码缓冲区在下次使用前释放, 避免偶尔解析的超大数据 (如大群的成员列表) 长期占用内存
+        static constexpr size_t DECODE_BUFFER_MAX_CAPACITY = 64 * 1024;
+
+        static constexpr size_t PARALLEL_DECODE_MIN_COUNT = 1024; // 少于此数的记录在当前线程中解析
+        static constexpr size_t PARALLEL_DECODE_MIN_CHUNK = 512; // 每个线程至少解析的记录数
+
+        // 把 tokens 分段, 第一段在当前线程中解析, 其余各段各用一个线程, 按原顺序追加到 result
+        template <typename Container>
+        static void _parallel_from_tokens(Container &result, const std::vector<std::string_view> &tokens) {
+            using T = typename Container::value_type;
+
+            const auto n = tokens.size();
+            const auto hardware_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            const auto chunks = std::max<size_t>(std::min(hardware_threads, n / PARALLEL_DECODE_MIN_CHUNK), 1);
+            const auto chunk_size = (n + chunks - 1) / chunks;
+
+            const auto decode = [&tokens](auto inserter, const size_t begin, const size_t end) {
+                for (auto i = begin; i < end; i++) {
+                    *inserter = T::from_bytes(tokens[i]);
+                }
+            };
+            const auto decode_part = [&decode](const size_t begin, const size_t end) {
+                std::vector<T> part;
+                part.reserve(end - begin);
+                decode(std::back_inserter(part), begin, end);
+                return part;
+            };
+
+            // tokens 指向当前线程的解码缓冲区, future 析构时会等待线程结束, 因此异常退出时也不会悬空
+            std::vector<std::future<std::vector<T>>> futures;
+            futures.reserve(chunks - 1);
+            for (size_t begin = chunk_size; begin < n; begin += chunk_size) {
+                futures.push_back(std::async(std::launch::async, decode_part, begin, std::min(begin + chunk_size, n)));
+            }
+
+            if constexpr (_has_reserve<Container>::value) {
+                result.reserve(n);
+            }
+            auto inserter = std::back_inserter(result);
+            decode(inserter, 0, std::min(chunk_size, n));
+            for (auto &future : futures) {
+                for (auto &obj : future.get()) {
+                    *inserter = std::move(obj);
+                }
+            }
+        }
+
+        static std::string _encode_base64(const std::string &bytes) {
+            return utils::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                        static_cast<unsigned int>(bytes.size()));
+        }
+
+        template <typename Container, typename = void>
+        struct _has_reserve : std::false_type {};
+
+        template <typename Container>
+        struct _has_reserve<Container, std::void_t<decltype(std::declval<Container &>().reserve(0))>>
+            : std::true_type {};
     };
 
     // 性别
@@ -57,22 +179,21 @@ namespace cq {
         int32_t age = 0; // 年龄
 
     private:
-        const static size_t MIN_SIZE = 18;
+        using Schema = utils::BinSchema<User,
+                                        utils::Field<&User::user_id, utils::wire::Int64>,
+                                        utils::Field<&User::nickname, utils::wire::String>,
+                                        utils::Field<&User::sex, utils::wire::Int32>,
+                                        utils::Field<&User::age, utils::wire::Int32>>;
 
         friend class ObjectHelper;
 
-        static User from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
-            User stranger;
-            try {
-                stranger.user_id = pack.pop_int<int64_t>();
-                stranger.nickname = pack.pop_string();
-                stranger.sex = static_cast<Sex>(pack.pop_int<int32_t>());
-                stranger.age = pack.pop_int<int32_t>();
-            } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to a User object");
-            }
-            return stranger;
+        static User from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto stranger = try_from_bytes(bytes)) return std::move(*stranger);
+            throw ParseError("failed to parse from bytes to a User object");
+        }
+
+        static std::optional<User> try_from_bytes(const std::string_view bytes) {
+            return Schema::try_decode(bytes);
         }
     };
 
@@ -83,21 +204,20 @@ namespace cq {
         std::string remark; // 备注
 
     private:
-        const static size_t MIN_SIZE = 12;
+        using Schema = utils::BinSchema<Friend,
+                                        utils::Field<&Friend::user_id, utils::wire::Int64>,
+                                        utils::Field<&Friend::nickname, utils::wire::String>,
+                                        utils::Field<&Friend::remark, utils::wire::String>>;
 
         friend class ObjectHelper;
 
-        static Friend from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
-            Friend frnd;
-            try {
-                frnd.user_id = pack.pop_int<int64_t>();
-                frnd.nickname = pack.pop_string();
-                frnd.remark = pack.pop_string();
-            } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to a Friend object");
-            }
-            return frnd;
+        static Friend from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto frnd = try_from_bytes(bytes)) return std::move(*frnd);
+            throw ParseError("failed to parse from bytes to a Friend object");
+        }
+
+        static std::optional<Friend> try_from_bytes(const std::string_view bytes) {
+            return Schema::try_decode(bytes);
         }
 
     private:
@@ -113,26 +233,30 @@ namespace cq {
         int32_t max_member_count = 0; // 最大成员数(容量), 仅 get_group_info() 返回
 
     private:
-        const static size_t MIN_SIZE = 10;
+        // get_group_list() 返回的群信息只有前两项
+        using ListSchema = utils::BinSchema<Group,
+                                            utils::Field<&Group::group_id, utils::wire::Int64>,
+                                            utils::Field<&Group::group_name, utils::wire::String>>;
+        using Schema = utils::BinSchema<Group,
+                                        utils::Field<&Group::group_id, utils::wire::Int64>,
+                                        utils::Field<&Group::group_name, utils::wire::String>,
+                                        utils::Field<&Group::member_count, utils::wire::Int32>,
+                                        utils::Field<&Group::max_member_count, utils::wire::Int32>>;
 
         friend class ObjectHelper;
 
-        static Group from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
+        static Group from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto group = try_from_bytes(bytes)) return std::move(*group);
+            throw ParseError("failed to parse from bytes to a Group object");
+        }
+
+        static std::optional<Group> try_from_bytes(std::string_view bytes) {
             Group group;
-            try {
-                group.group_id = pack.pop_int<int64_t>();
-                group.group_name = pack.pop_string();
-                try {
-                    // 尝试获取 member_count 和 max_member_count,
-                    // 如果正在处理的是 get_group_list() 的返回结果, 会失败, 将忽略异常继续
-                    group.member_count = pack.pop_int<int32_t>();
-                    group.max_member_count = pack.pop_int<int32_t>();
-                } catch (BytesNotEnough &) {
-                }
-            } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to a Group object");
-            }
+            if (!ListSchema::decode(bytes, group)) return std::nullopt;
+            // 尝试获取 member_count 和 max_member_count,
+            // 如果正在处理的是 get_group_list() 的返回结果, 没有这两项, 保持默认值
+            auto pack = utils::BinPackView(bytes);
+            if (pack.try_pop_int(group.member_count)) pack.try_pop_int(group.max_member_count);
             return group;
         }
     };
@@ -156,36 +280,230 @@ namespace cq {
         bool card_changeable = false; // 是否可修改名片
 
     private:
-        const static size_t MIN_SIZE = 58;
+        using Schema = utils::BinSchema<GroupMember,
+                                        utils::Field<&GroupMember::group_id, utils::wire::Int64>,
+                                        utils::Field<&GroupMember::user_id, utils::wire::Int64>,
+                                        utils::Field<&GroupMember::nickname, utils::wire::String>,
+                                        utils::Field<&GroupMember::card, utils::wire::String>,
+                                        utils::Field<&GroupMember::sex, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::age, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::area, utils::wire::String>,
+                                        utils::Field<&GroupMember::join_time, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::last_sent_time, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::level, utils::wire::String>,
+                                        utils::Field<&GroupMember::role, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::unfriendly, utils::wire::Bool>,
+                                        utils::Field<&GroupMember::title, utils::wire::String>,
+                                        utils::Field<&GroupMember::title_expire_time, utils::wire::Int32>,
+                                        utils::Field<&GroupMember::card_changeable, utils::wire::Bool>>;
 
         friend class ObjectHelper;
 
-        static GroupMember from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
+        static GroupMember from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto member = try_from_bytes(bytes)) return std::move(*member);
+            throw ParseError("failed to parse from bytes to a GroupMember object");
+        }
+
+        static std::optional<GroupMember> try_from_bytes(const std::string_view bytes) {
+            return Schema::try_decode(bytes);
+        }
+    };
+
+    // 按列存储的群成员列表, 定长字段在构造时解出, 字符串字段只记录在原始数据中的位置, 访问时才转换编码;
+    // 适合只关心部分字段 (如 user_id, role) 的大群遍历
+    class GroupMemberTable {
+    public:
+        size_t size() const noexcept {
+            return user_ids_.size();
+        }
+
+        bool empty() const noexcept {
+            return user_ids_.empty();
+        }
+
+        int64_t group_id(const size_t i) const {
+            return group_ids_[i];
+        }
+
+        int64_t user_id(const size_t i) const {
+            return user_ids_[i];
+        }
+
+        Sex sex(const size_t i) const {
+            return sexes_[i];
+        }
+
+        int32_t age(const size_t i) const {
+            return ages_[i];
+        }
+
+        int32_t join_time(const size_t i) const {
+            return join_times_[i];
+        }
+
+        int32_t last_sent_time(const size_t i) const {
+            return last_sent_times_[i];
+        }
+
+        GroupRole role(const size_t i) const {
+            return roles_[i];
+        }
+
+        bool unfriendly(const size_t i) const {
+            return unfriendlies_[i];
+        }
+
+        int32_t title_expire_time(const size_t i) const {
+            return title_expire_times_[i];
+        }
+
+        bool card_changeable(const size_t i) const {
+            return card_changeables_[i];
+        }
+
+        std::string nickname(const size_t i) const {
+            return string_at(i, NICKNAME);
+        }
+
+        std::string card(const size_t i) const {
+            return string_at(i, CARD);
+        }
+
+        std::string area(const size_t i) const {
+            return string_at(i, AREA);
+        }
+
+        std::string level(const size_t i) const {
+            return string_at(i, LEVEL);
+        }
+
+        std::string title(const size_t i) const {
+            return string_at(i, TITLE);
+        }
+
+        // 取出第 i 个成员的完整信息
+        GroupMember operator[](const size_t i) const {
             GroupMember member;
+            member.group_id = group_id(i);
+            member.user_id = user_id(i);
+            member.nickname = nickname(i);
+            member.card = card(i);
+            member.sex = sex(i);
+            member.age = age(i);
+            member.area = area(i);
+            member.join_time = join_time(i);
+            member.last_sent_time = last_sent_time(i);
+            member.level = level(i);
+            member.role = role(i);
+            member.unfriendly = unfriendly(i);
+            member.title = title(i);
+            member.title_expire_time = title_expire_time(i);
+            member.card_changeable = card_changeable(i);
+            return member;
+        }
+
+    private:
+        enum StringField { NICKNAME, CARD, AREA, LEVEL, TITLE, STRING_FIELD_COUNT };
+
+        // 字符串在 bytes_ 中的位置
+        struct StringRef {
+            uint32_t offset;
+            uint16_t size;
+        };
+
+        friend class ObjectHelper;
+
+        std::string bytes_;
+        std::vector<int64_t> group_ids_;
+        std::vector<int64_t> user_ids_;
+        std::vector<Sex> sexes_;
+        std::vector<int32_t> ages_;
+        std::vector<int32_t> join_times_;
+        std::vector<int32_t> last_sent_times_;
+        std::vector<GroupRole> roles_;
+        std::vector<bool> unfriendlies_;
+        std::vector<int32_t> title_expire_times_;
+        std::vector<bool> card_changeables_;
+        std::vector<StringRef> strings_; // 每个成员 STRING_FIELD_COUNT 项
+
+        std::string string_at(const size_t i, const StringField field) const {
+            const auto &ref = strings_[i * STRING_FIELD_COUNT + field];
+            if (ref.size == 0) {
+                return std::string();
+            }
+            return utils::string_from_coolq(std::string_view(bytes_).substr(ref.offset, ref.size));
+        }
+
+        // 格式与 ObjectHelper::multi_from_base64<std::vector<GroupMember>> 相同
+        static GroupMemberTable from_bytes(const std::string_view bytes) noexcept(false) {
+            return from_bytes(std::string(bytes));
+        }
+
+        // 接管已解码的数据, 不再复制
+        static GroupMemberTable from_bytes(std::string &&bytes) noexcept(false) {
+            GroupMemberTable table;
+            table.bytes_ = std::move(bytes);
+            auto pack = utils::BinPackView(table.bytes_);
             try {
-                member.group_id = pack.pop_int<int64_t>();
-                member.user_id = pack.pop_int<int64_t>();
-                member.nickname = pack.pop_string();
-                member.card = pack.pop_string();
-                member.sex = static_cast<Sex>(pack.pop_int<int32_t>());
-                member.age = pack.pop_int<int32_t>();
-                member.area = pack.pop_string();
-                member.join_time = pack.pop_int<int32_t>();
-                member.last_sent_time = pack.pop_int<int32_t>();
-                member.level = pack.pop_string();
-                member.role = static_cast<GroupRole>(pack.pop_int<int32_t>());
-                member.unfriendly = pack.pop_bool();
-                member.title = pack.pop_string();
-                member.title_expire_time = pack.pop_int<int32_t>();
-                member.card_changeable = pack.pop_bool();
+                const auto count = pack.pop_int<int32_t>();
+                // 每条记录至少有 2 字节的长度前缀, 不按不可信的 count 预留过多空间
+                if (count > 0) table.reserve(std::min(static_cast<size_t>(count), pack.size() / 2));
+                for (auto i = 0; i < count; i++) {
+                    table.push(utils::BinPackView(pack.pop_token()));
+                }
             } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to a GroupMember object");
+                throw ParseError("failed to parse from bytes to a GroupMemberTable object");
             }
-            return member;
+            return table;
+        }
+
+        void reserve(const size_t n) {
+            group_ids_.reserve(n);
+            user_ids_.reserve(n);
+            sexes_.reserve(n);
+            ages_.reserve(n);
+            join_times_.reserve(n);
+            last_sent_times_.reserve(n);
+            roles_.reserve(n);
+            unfriendlies_.reserve(n);
+            title_expire_times_.reserve(n);
+            card_changeables_.reserve(n);
+            strings_.reserve(n * STRING_FIELD_COUNT);
+        }
+
+        // 解析一条成员记录, 字段顺序见 GroupMember::from_bytes
+        void push(utils::BinPackView pack) {
+            const auto push_string = [&] {
+                const auto token = pack.pop_token();
+                strings_.push_back(StringRef{static_cast<uint32_t>(token.data() - bytes_.data()),
+                                             static_cast<uint16_t>(token.size())});
+            };
+            group_ids_.push_back(pack.pop_int<int64_t>());
+            user_ids_.push_back(pack.pop_int<int64_t>());
+            push_string(); // nickname
+            push_string(); // card
+            sexes_.push_back(static_cast<Sex>(pack.pop_int<int32_t>()));
+            ages_.push_back(pack.pop_int<int32_t>());
+            push_string(); // area
+            join_times_.push_back(pack.pop_int<int32_t>());
+            last_sent_times_.push_back(pack.pop_int<int32_t>());
+            push_string(); // level
+            roles_.push_back(static_cast<GroupRole>(pack.pop_int<int32_t>()));
+            unfriendlies_.push_back(pack.pop_bool());
+            push_string(); // title
+            title_expire_times_.push_back(pack.pop_int<int32_t>());
+            card_changeables_.push_back(pack.pop_bool());
         }
     };
 
+    // 表中的字符串字段指向解码后的数据, 因此直接解码到由表接管的字符串, 而不是先解码到线程缓冲区再复制
+    template <>
+    inline GroupMemberTable ObjectHelper::from_base64<GroupMemberTable>(const std::string_view b64) {
+        std::string bytes;
+        utils::base64_decode_to(bytes, b64);
+        return GroupMemberTable::from_bytes(std::move(bytes));
+    }
+
     // 匿名信息
     struct Anonymous {
         int64_t id = 0; // ID, 具体含义不明
@@ -194,32 +512,37 @@ namespace cq {
         std::string base64; // 整个 Anonymous 对象的 Base64 编码字符串
 
     private:
-        const static size_t MIN_SIZE = 12;
+        // 不含 base64 属性, 它在下面特化的 ObjectHelper::try_from_base64 函数中赋值
+        using Schema = utils::BinSchema<Anonymous,
+                                        utils::Field<&Anonymous::id, utils::wire::Int64>,
+                                        utils::Field<&Anonymous::name, utils::wire::String>,
+                                        utils::Field<&Anonymous::token, utils::wire::Bytes>>;
 
         friend class ObjectHelper;
 
-        static Anonymous from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
-            Anonymous anonymous;
-            try {
-                anonymous.id = pack.pop_int<int64_t>();
-                anonymous.name = pack.pop_string();
-                anonymous.token = pack.pop_token();
-                // 注意: 这里不给 base64 属性赋值, 而是在下面特化的 ObjectHelper::from_base64 函数中赋值
-            } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to an Anonymous object");
-            }
-            return anonymous;
+        static Anonymous from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto anonymous = try_from_bytes(bytes)) return std::move(*anonymous);
+            throw ParseError("failed to parse from bytes to an Anonymous object");
+        }
+
+        static std::optional<Anonymous> try_from_bytes(const std::string_view bytes) {
+            return Schema::try_decode(bytes);
         }
     };
 
     template <>
-    inline Anonymous ObjectHelper::from_base64<Anonymous>(const std::string &b64) {
-        auto anonymous = Anonymous::from_bytes(utils::base64_decode(b64));
-        anonymous.base64 = b64;
+    inline std::optional<Anonymous> ObjectHelper::try_from_base64<Anonymous>(const std::string_view b64) {
+        auto anonymous = Anonymous::try_from_bytes(_decode_base64(b64));
+        if (anonymous) anonymous->base64 = std::string(b64);
         return anonymous;
     }
 
+    template <>
+    inline Anonymous ObjectHelper::from_base64<Anonymous>(const std::string_view b64) {
+        if (auto anonymous = try_from_base64<Anonymous>(b64)) return std::move(*anonymous);
+        throw ParseError("failed to parse from bytes to an Anonymous object");
+    }
+
     // 文件信息
     struct File {
         std::string id; // ID
@@ -228,22 +551,21 @@ namespace cq {
         int64_t busid = 0; // 某种 ID, 具体含义不明
 
     private:
-        const static size_t MIN_SIZE = 20;
+        using Schema = utils::BinSchema<File,
+                                        utils::Field<&File::id, utils::wire::String>,
+                                        utils::Field<&File::name, utils::wire::String>,
+                                        utils::Field<&File::size, utils::wire::Int64>,
+                                        utils::Field<&File::busid, utils::wire::Int64>>;
 
         friend class ObjectHelper;
 
-        static File from_bytes(std::string &&bytes) noexcept(false) {
-            auto pack = utils::BinPack(bytes);
-            File file;
-            try {
-                file.id = pack.pop_string();
-                file.name = pack.pop_string();
-                file.size = pack.pop_int<int64_t>();
-                file.busid = pack.pop_int<int64_t>();
-            } catch (BytesNotEnough &) {
-                throw ParseError("failed to parse from bytes to a File object");
-            }
-            return file;
+        static File from_bytes(const std::string_view bytes) noexcept(false) {
+            if (auto file = try_from_bytes(bytes)) return std::move(*file);
+            throw ParseError("failed to parse from bytes to a File object");
+        }
+
+        static std::optional<File> try_from_bytes(const std::string_view bytes) {
+            return Schema::try_decode(bytes);
         }
     };
 } // namespace cq
@@ -47,6 +47,19 @@ namespace cq {
         return ++curr_message_id;
     }
 
+    // bytes() 已是 GB18030 编码, 转换回 UTF-8 后再输出
+    int64_t send_private_message(const int64_t user_id, const EncodedMessage &message) {
+        return send_private_message(user_id, utils::string_from_coolq(message.bytes()));
+    }
+
+    int64_t send_group_message(const int64_t group_id, const EncodedMessage &message) {
+        return send_group_message(group_id, utils::string_from_coolq(message.bytes()));
+    }
+
+    int64_t send_discuss_message(const int64_t discuss_id, const EncodedMessage &message) {
+        return send_discuss_message(discuss_id, utils::string_from_coolq(message.bytes()));
+    }
+
     void delete_message(const int64_t message_id) {
         print_api_call("delete_message", pair{"message_id", message_id});
     }
@@ -181,6 +194,11 @@ namespace cq {
         return {};
     }
 
+    GroupMemberTable get_group_member_table(const int64_t group_id) {
+        print_api_call("get_group_member_table", pair{"group_id", group_id});
+        return {};
+    }
+
     GroupMember get_group_member_info(const int64_t group_id, const int64_t user_id, const bool no_cache) {
         print_api_call(
             "get_group_info", pair{"group_id", group_id}, pair{"user_id", user_id}, pair{"no_cache", no_cache});
@@ -13,7 +13,7 @@
 using std::enable_if_t;
 using std::is_integral_v;
 using std::is_pointer_v;
-using cq::utils::string_to_coolq;
+using cq::utils::string_to_coolq_cstr;
 using cq::utils::string_from_coolq;
 
 namespace cq {
@@ -53,15 +53,27 @@ namespace cq {
 #pragma region Message
 
     int64_t send_private_message(const int64_t user_id, const std::string &message) {
-        return static_cast<int64_t>(chk(raw::CQ_sendPrivateMsg(_ac(), user_id, string_to_coolq(message).c_str())));
+        return static_cast<int64_t>(chk(raw::CQ_sendPrivateMsg(_ac(), user_id, string_to_coolq_cstr(message))));
     }
 
     int64_t send_group_message(const int64_t group_id, const std::string &message) {
-        return static_cast<int64_t>(chk(raw::CQ_sendGroupMsg(_ac(), group_id, string_to_coolq(message).c_str())));
+        return static_cast<int64_t>(chk(raw::CQ_sendGroupMsg(_ac(), group_id, string_to_coolq_cstr(message))));
     }
 
     int64_t send_discuss_message(const int64_t discuss_id, const std::string &message) {
-        return static_cast<int64_t>(chk(raw::CQ_sendDiscussMsg(_ac(), discuss_id, string_to_coolq(message).c_str())));
+        return static_cast<int64_t>(chk(raw::CQ_sendDiscussMsg(_ac(), discuss_id, string_to_coolq_cstr(message))));
+    }
+
+    int64_t send_private_message(const int64_t user_id, const EncodedMessage &message) {
+        return static_cast<int64_t>(chk(raw::CQ_sendPrivateMsg(_ac(), user_id, message.c_str())));
+    }
+
+    int64_t send_group_message(const int64_t group_id, const EncodedMessage &message) {
+        return static_cast<int64_t>(chk(raw::CQ_sendGroupMsg(_ac(), group_id, message.c_str())));
+    }
+
+    int64_t send_discuss_message(const int64_t discuss_id, const EncodedMessage &message) {
+        return static_cast<int64_t>(chk(raw::CQ_sendDiscussMsg(_ac(), discuss_id, message.c_str())));
     }
 
     void delete_message(const int64_t message_id) {
@@ -105,7 +117,7 @@ namespace cq {
     }
 
     void set_group_card(const int64_t group_id, const int64_t user_id, const std::string &card) {
-        chk(raw::CQ_setGroupCard(_ac(), group_id, user_id, string_to_coolq(card).c_str()));
+        chk(raw::CQ_setGroupCard(_ac(), group_id, user_id, string_to_coolq_cstr(card)));
     }
 
     void set_group_leave(const int64_t group_id, const bool dismiss) {
@@ -114,7 +126,7 @@ namespace cq {
 
     void set_group_special_title(const int64_t group_id, const int64_t user_id, const std::string &special_title,
                                  const int64_t duration) {
-        chk(raw::CQ_setGroupSpecialTitle(_ac(), group_id, user_id, string_to_coolq(special_title).c_str(), duration));
+        chk(raw::CQ_setGroupSpecialTitle(_ac(), group_id, user_id, string_to_coolq_cstr(special_title), duration));
     }
 
     void set_discuss_leave(const int64_t discuss_id) {
@@ -128,16 +140,16 @@ namespace cq {
     void set_friend_request(const RequestEvent::Flag &flag, const RequestEvent::Operation operation,
                             const std::string &remark) {
         chk(raw::CQ_setFriendAddRequest(
-            _ac(), string_to_coolq(flag).c_str(), static_cast<int32_t>(operation), string_to_coolq(remark).c_str()));
+            _ac(), string_to_coolq_cstr<0>(flag.raw), static_cast<int32_t>(operation), string_to_coolq_cstr<1>(remark)));
     }
 
     void set_group_request(const RequestEvent::Flag &flag, const GroupRequestEvent::SubType &sub_type,
                            const RequestEvent::Operation operation, const std::string &reason) {
         chk(raw::CQ_setGroupAddRequestV2(_ac(),
-                                         string_to_coolq(flag).c_str(),
+                                         string_to_coolq_cstr<0>(flag.raw),
                                          static_cast<int32_t>(sub_type),
                                          static_cast<int32_t>(operation),
-                                         string_to_coolq(reason).c_str()));
+                                         string_to_coolq_cstr<1>(reason)));
     }
 
 #pragma endregion
@@ -193,6 +205,14 @@ namespace cq {
         }
     }
 
+    GroupMemberTable get_group_member_table(const int64_t group_id) {
+        try {
+            return ObjectHelper::from_base64<GroupMemberTable>(chk(raw::CQ_getGroupMemberList(_ac(), group_id)));
+        } catch (ParseError &) {
+            throw ApiError(ApiError::INVALID_DATA);
+        }
+    }
+
     GroupMember get_group_member_info(const int64_t group_id, const int64_t user_id, const bool no_cache) {
         try {
             return ObjectHelper::from_base64<GroupMember>(
@@ -207,7 +227,7 @@ namespace cq {
 #pragma region CoolQ
 
     std::string get_cookies(const std::string &domain) {
-        return string_from_coolq(chk(raw::CQ_getCookiesV2(_ac(), string_to_coolq(domain).c_str())));
+        return string_from_coolq(chk(raw::CQ_getCookiesV2(_ac(), string_to_coolq_cstr(domain))));
     }
 
     int32_t get_csrf_token() {
@@ -227,13 +247,13 @@ namespace cq {
     }
 
     std::string get_image(const std::string &file) {
-        return string_from_coolq(chk(raw::CQ_getImage(_ac(), string_to_coolq(file).c_str())));
+        return string_from_coolq(chk(raw::CQ_getImage(_ac(), string_to_coolq_cstr(file))));
     }
 
     std::string get_record(const std::string &file, const std::string &out_format, const bool full_path) {
         return string_from_coolq(chk(
-            full_path ? raw::CQ_getRecordV2(_ac(), string_to_coolq(file).c_str(), string_to_coolq(out_format).c_str())
-                      : raw::CQ_getRecord(_ac(), string_to_coolq(file).c_str(), string_to_coolq(out_format).c_str())));
+            full_path ? raw::CQ_getRecordV2(_ac(), string_to_coolq_cstr<0>(file), string_to_coolq_cstr<1>(out_format))
+                      : raw::CQ_getRecord(_ac(), string_to_coolq_cstr<0>(file), string_to_coolq_cstr<1>(out_format))));
     }
 
     bool can_send_image() {
@@ -245,7 +265,7 @@ namespace cq {
     }
 
     void add_log(const int32_t level, const std::string &tag, const std::string &message) {
-        chk(raw::CQ_addLog(_ac(), level, string_to_coolq(tag).c_str(), string_to_coolq(message).c_str()));
+        chk(raw::CQ_addLog(_ac(), level, string_to_coolq_cstr<0>(tag), string_to_coolq_cstr<1>(message)));
     }
 
 #pragma endregion
@@ -117,10 +117,12 @@ _CQ_EVENT(int32_t, cq_event_private_message, 24)
 _CQ_EVENT(int32_t, cq_event_group_message, 36)
 (int32_t sub_type, int32_t msg_id, int64_t from_group, int64_t from_qq, const char *from_anonymous_base64,
  const char *msg, int32_t font) {
+    // 非匿名消息的 from_anonymous_base64 为空, 解析失败时不抛出异常
     Anonymous anonymous;
-    try {
-        anonymous = ObjectHelper::from_base64<Anonymous>(from_anonymous_base64);
-    } catch (ParseError &) {
+    if (from_anonymous_base64 && *from_anonymous_base64) {
+        if (auto parsed = ObjectHelper::try_from_base64<Anonymous>(from_anonymous_base64)) {
+            anonymous = std::move(*parsed);
+        }
     }
     auto e = GroupMessageEvent(
         from_qq, static_cast<int64_t>(msg_id), string_from_coolq(msg), font, from_group, std::move(anonymous));
@@ -150,9 +152,10 @@ _CQ_EVENT(int32_t, cq_event_discuss_message, 32)
 _CQ_EVENT(int32_t, cq_event_group_upload, 28)
 (int32_t sub_type, int32_t send_time, int64_t from_group, int64_t from_qq, const char *file_base64) {
     File file;
-    try {
-        file = ObjectHelper::from_base64<File>(file_base64);
-    } catch (ParseError &) {
+    if (file_base64) {
+        if (auto parsed = ObjectHelper::try_from_base64<File>(file_base64)) {
+            file = std::move(*parsed);
+        }
     }
     auto e = GroupUploadEvent(from_qq, from_group, std::move(file));
     call_all_catch_all(cq::_group_upload_callbacks(), e);
@@ -1,13 +1,188 @@
 #include "base64.hpp"
 
-#include "./vendor/cpp-base64/base64.h"
+#include <array>
+#include <cstdint>
+
+#include "simd.hpp"
 
 namespace cq::utils {
+    static constexpr std::string_view BASE64_CHARS =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    static constexpr uint8_t BASE64_INVALID = 0xFF;
+
+    // Base64 字符到 6 位值的查找表, 非 Base64 字符为 BASE64_INVALID
+    static constexpr auto BASE64_DECODE_TABLE = [] {
+        std::array<uint8_t, 256> table{};
+        for (auto &v : table) v = BASE64_INVALID;
+        for (size_t i = 0; i < BASE64_CHARS.size(); i++) {
+            table[static_cast<uint8_t>(BASE64_CHARS[i])] = static_cast<uint8_t>(i);
+        }
+        return table;
+    }();
+
+    // SIMD 解码时每次写出的字节数可能超出实际解码结果, 输出缓冲区需预留的空间
+    static constexpr size_t BASE64_DECODE_SLACK = 8;
+
     std::string base64_encode(const unsigned char *bytes, const unsigned int len) {
-        return ::base64_encode(bytes, len);
+        std::string result((static_cast<size_t>(len) + 2) / 3 * 4, '=');
+        auto dst = &result[0];
+        unsigned int i = 0;
+        for (; i + 3 <= len; i += 3) {
+            const auto v = (static_cast<uint32_t>(bytes[i]) << 16) | (static_cast<uint32_t>(bytes[i + 1]) << 8)
+                           | bytes[i + 2];
+            dst[0] = BASE64_CHARS[v >> 18];
+            dst[1] = BASE64_CHARS[(v >> 12) & 0x3F];
+            dst[2] = BASE64_CHARS[(v >> 6) & 0x3F];
+            dst[3] = BASE64_CHARS[v & 0x3F];
+            dst += 4;
+        }
+        if (i < len) {
+            // 剩余 1 或 2 字节, 不足的部分以 '=' 填充
+            auto v = static_cast<uint32_t>(bytes[i]) << 16;
+            if (i + 1 < len) v |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+            dst[0] = BASE64_CHARS[v >> 18];
+            dst[1] = BASE64_CHARS[(v >> 12) & 0x3F];
+            if (i + 1 < len) dst[2] = BASE64_CHARS[(v >> 6) & 0x3F];
+        }
+        return result;
     }
 
     std::string base64_decode(const std::string &str) {
-        return ::base64_decode(str);
+        std::string result;
+        base64_decode_to(result, str);
+        return result;
+    }
+
+    // 逐字符解码, 遇到非 Base64 字符时停止, 返回停止处的下标
+    static size_t _base64_decode_scalar(const uint8_t *in, size_t i, const size_t n, uint8_t *&dst) {
+        const auto &table = BASE64_DECODE_TABLE;
+
+        // 完整的 4 字符组
+        for (; i + 4 <= n; i += 4) {
+            const uint32_t a = table[in[i]], b = table[in[i + 1]], c = table[in[i + 2]], d = table[in[i + 3]];
+            if ((a | b | c | d) & 0x80) break; // 含有非 Base64 字符
+            const auto v = (a << 18) | (b << 12) | (c << 6) | d;
+            dst[0] = static_cast<uint8_t>(v >> 16);
+            dst[1] = static_cast<uint8_t>(v >> 8);
+            dst[2] = static_cast<uint8_t>(v);
+            dst += 3;
+        }
+
+        // 剩余不足 4 个的有效字符, 2 个字符解出 1 字节, 3 个字符解出 2 字节
+        uint32_t v = 0;
+        size_t k = 0;
+        for (; i < n && k < 3; i++, k++) {
+            const auto x = table[in[i]];
+            if (x == BASE64_INVALID) break;
+            v = (v << 6) | x;
+        }
+        if (k >= 2) {
+            v <<= (4 - k) * 6;
+            *dst++ = static_cast<uint8_t>(v >> 16);
+            if (k == 3) *dst++ = static_cast<uint8_t>(v >> 8);
+        }
+        return i;
+    }
+
+#ifdef CQ_SIMD_X86
+    // 以 16 字节为一组解码 (见 W. Muła, D. Lemire, "Faster Base64 Encoding and Decoding Using AVX2 Instructions"),
+    // 遇到含有非 Base64 字符的组时停止, 返回已解码的字符数
+    CQ_TARGET_SSSE3 static size_t _base64_decode_ssse3(const uint8_t *in, const size_t n, uint8_t *&dst) {
+        // 按高低半字节查表检查字符是否合法, 两者按位与不为 0 即非法
+        const auto lut_lo = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lut_hi = _mm_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        // 按高半字节 (及是否为 '/') 查出字符到 6 位值的偏移
+        const auto lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask_2f = _mm_set1_epi8(0x2F);
+        const auto shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+        size_t i = 0;
+        for (; i + 16 <= n; i += 16) {
+            const auto str = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+            const auto hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+            const auto lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(str, mask_2f));
+            const auto hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) break;
+
+            const auto eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+            const auto roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+            const auto values = _mm_add_epi8(str, roll);
+
+            // 每 4 个 6 位值合并为 24 位, 再按大端序取出 3 字节
+            const auto merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)),
+                                               _mm_set1_epi32(0x00011000));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_shuffle_epi8(merged, shuffle));
+            dst += 12;
+        }
+        return i;
+    }
+
+    // 与 _base64_decode_ssse3 相同, 每组 32 字节
+    CQ_TARGET_AVX2 static size_t _base64_decode_avx2(const uint8_t *in, const size_t n, uint8_t *&dst) {
+        const auto lut_lo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const auto lut_hi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const auto lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                               0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const auto mask_2f = _mm256_set1_epi8(0x2F);
+        const auto shuffle = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        // 把两个 128 位通道中各自的 12 字节拼接到一起
+        const auto permute = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, -1, -1);
+
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const auto str = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+            const auto hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+            const auto lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(str, mask_2f));
+            const auto hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            if (!_mm256_testz_si256(lo, hi)) break;
+
+            const auto eq_2f = _mm256_cmpeq_epi8(str, mask_2f);
+            const auto roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+            const auto values = _mm256_add_epi8(str, roll);
+
+            const auto merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)),
+                                                  _mm256_set1_epi32(0x00011000));
+            const auto packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, shuffle), permute);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), packed);
+            dst += 24;
+        }
+        return i + _base64_decode_ssse3(in + i, n - i, dst);
+    }
+#endif
+
+    bool base64_decode_to(std::string &out, const std::string_view str) {
+        const auto in = reinterpret_cast<const uint8_t *>(str.data());
+        const auto n = str.size();
+
+        const auto old_size = out.size();
+        out.resize(old_size + n / 4 * 3 + 2 + BASE64_DECODE_SLACK);
+        const auto out_begin = reinterpret_cast<uint8_t *>(&out[old_size]);
+        auto dst = out_begin;
+
+        size_t i = 0;
+#ifdef CQ_SIMD_X86
+        // 先按组快速解码, 余下的部分 (包括填充和非法字符) 逐字符处理
+        if (n >= 32 && simd::cpu_features().avx2) {
+            i = _base64_decode_avx2(in, n, dst);
+        } else if (n >= 16 && simd::cpu_features().ssse3) {
+            i = _base64_decode_ssse3(in, n, dst);
+        }
+#endif
+        i = _base64_decode_scalar(in, i, n, dst);
+        out.resize(old_size + (dst - out_begin));
+
+        // 检查是否为格式正确的 Base64: 有效字符之后只能是补齐到 4 的倍数的 '='
+        const auto rest = str.substr(i);
+        const auto padding = (4 - i % 4) % 4;
+        if (i % 4 == 1) return false;
+        return rest.empty() || (padding > 0 && rest == std::string_view("==", padding));
     }
 } // namespace cq::utils
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace cq::utils {
     std::string base64_encode(const unsigned char *bytes, unsigned int len);
     std::string base64_decode(const std::string &str);
+
+    // 将 Base64 字符串解码后追加到 out, 可复用 out 已有的容量; 遇到 '=' 或非 Base64 字符时停止.
+    // 返回 str 是否为格式正确的 Base64 (末尾的 '=' 填充可以省略), 不正确时 out 中为停止前解出的内容;
+    // x86 下按 CPU 支持使用 AVX2 或 SSSE3 解码
+    bool base64_decode_to(std::string &out, std::string_view str);
 } // namespace cq::utils
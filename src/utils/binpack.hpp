@@ -1,6 +1,13 @@
 #pragma once
 
-#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
 
 #include "string.hpp"
 
@@ -16,6 +23,148 @@ namespace cq {
 } // namespace cq
 
 namespace cq::utils {
+    inline uint8_t _bswap(const uint8_t value) noexcept {
+        return value;
+    }
+
+#if defined(_MSC_VER) && !defined(__clang__)
+    inline uint16_t _bswap(const uint16_t value) noexcept {
+        return _byteswap_ushort(value);
+    }
+
+    inline uint32_t _bswap(const uint32_t value) noexcept {
+        return _byteswap_ulong(value);
+    }
+
+    inline uint64_t _bswap(const uint64_t value) noexcept {
+        return _byteswap_uint64(value);
+    }
+#else
+    inline uint16_t _bswap(const uint16_t value) noexcept {
+        return __builtin_bswap16(value);
+    }
+
+    inline uint32_t _bswap(const uint32_t value) noexcept {
+        return __builtin_bswap32(value);
+    }
+
+    inline uint64_t _bswap(const uint64_t value) noexcept {
+        return __builtin_bswap64(value);
+    }
+#endif
+
+    // 从 data 读取一个大端序整数 (酷Q的二进制数据均为大端序, 运行环境为小端序)
+    template <typename IntType>
+    inline IntType _read_big_endian(const char *data) noexcept {
+        static_assert(std::is_integral_v<IntType>, "IntType must be an integral type");
+        using UInt = std::make_unsigned_t<IntType>;
+        UInt raw;
+        std::memcpy(&raw, data, sizeof(raw));
+        return static_cast<IntType>(_bswap(raw));
+    }
+
+    // 不持有数据的 BinPack, 整数直接从原始数据中读取, 字节串以视图形式返回, 不复制;
+    // 调用者需保证原始数据在使用期间有效
+    class BinPackView {
+    public:
+        BinPackView() = default;
+
+        explicit BinPackView(const std::string_view bytes) : bytes_(bytes) {
+        }
+
+        size_t size() const noexcept {
+            return bytes_.size();
+        }
+
+        bool empty() const noexcept {
+            return bytes_.empty();
+        }
+
+        template <typename IntType>
+        IntType pop_int() {
+            IntType result;
+            if (!try_pop_int(result)) throw_not_enough(sizeof(IntType));
+            return result;
+        }
+
+        std::string pop_string() {
+            std::string result;
+            if (!try_pop_string(result)) throw_not_enough_for_token();
+            return result;
+        }
+
+        std::string_view pop_bytes(const size_t len) {
+            std::string_view result;
+            if (!try_pop_bytes(len, result)) throw_not_enough(len);
+            return result;
+        }
+
+        std::string_view pop_token() {
+            std::string_view result;
+            if (!try_pop_token(result)) throw_not_enough_for_token();
+            return result;
+        }
+
+        bool pop_bool() {
+            return static_cast<bool>(pop_int<int32_t>());
+        }
+
+        // 以下 try_pop_* 不抛出异常, 数据不足时返回 false, 且不修改 out 和剩余数据;
+        // 用于字段可选或经常解析失败的场合
+
+        template <typename IntType>
+        bool try_pop_int(IntType &out) noexcept {
+            constexpr auto size = sizeof(IntType);
+            if (size > bytes_.size()) return false;
+            out = _read_big_endian<IntType>(bytes_.data());
+            bytes_.remove_prefix(size);
+            return true;
+        }
+
+        bool try_pop_bytes(const size_t len, std::string_view &out) noexcept {
+            if (len > bytes_.size()) return false;
+            out = bytes_.substr(0, len);
+            bytes_.remove_prefix(len);
+            return true;
+        }
+
+        bool try_pop_token(std::string_view &out) noexcept {
+            if (sizeof(int16_t) > bytes_.size()) return false;
+            const auto len = static_cast<uint16_t>(_read_big_endian<int16_t>(bytes_.data()));
+            if (sizeof(int16_t) + len > bytes_.size()) return false;
+            out = bytes_.substr(sizeof(int16_t), len);
+            bytes_.remove_prefix(sizeof(int16_t) + len);
+            return true;
+        }
+
+        bool try_pop_string(std::string &out) {
+            std::string_view bytes;
+            if (!try_pop_token(bytes)) return false;
+            out = bytes.empty() ? std::string() : string_from_coolq(bytes);
+            return true;
+        }
+
+        bool try_pop_bool(bool &out) noexcept {
+            int32_t value;
+            if (!try_pop_int(value)) return false;
+            out = static_cast<bool>(value);
+            return true;
+        }
+
+    private:
+        std::string_view bytes_;
+
+        [[noreturn]] void throw_not_enough(const size_t needed) const noexcept(false) {
+            throw BytesNotEnough(size(), needed);
+        }
+
+        // 长度前缀本身不足时报告缺少的前缀字节, 否则报告记录所需的字节数
+        [[noreturn]] void throw_not_enough_for_token() const noexcept(false) {
+            if (size() < sizeof(int16_t)) throw_not_enough(sizeof(int16_t));
+            throw_not_enough(sizeof(int16_t) + static_cast<uint16_t>(_read_big_endian<int16_t>(bytes_.data())));
+        }
+    };
+
     class BinPack {
     public:
         BinPack() : bytes_(""), curr_(0) {
@@ -40,12 +189,8 @@ namespace cq::utils {
             constexpr auto size = sizeof(IntType);
             check_enough(size);
 
-            auto s = bytes_.substr(curr_, size);
+            const auto result = _read_big_endian<IntType>(bytes_.data() + curr_);
             curr_ += size;
-            std::reverse(s.begin(), s.end());
-
-            IntType result;
-            std::memcpy(static_cast<void *>(&result), s.data(), size);
             return result;
         }
 
@@ -55,7 +200,7 @@ namespace cq::utils {
                 return std::string();
             }
             check_enough(len);
-            auto result = string_from_coolq(bytes_.substr(curr_, len));
+            auto result = string_from_coolq(std::string_view(bytes_).substr(curr_, len));
             curr_ += len;
             return result;
         }
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "binpack.hpp"
+#include "string.hpp"
+
+namespace cq::utils {
+    // 酷Q二进制数据中字段的存储格式
+    namespace wire {
+        // 大端序定长整数, 对应的成员可以是整数, 枚举或 bool
+        template <typename IntType>
+        struct Int {
+            using type = IntType;
+            static constexpr bool VARIABLE = false;
+            static constexpr size_t FIXED_SIZE = sizeof(IntType);
+        };
+
+        using Int16 = Int<int16_t>;
+        using Int32 = Int<int32_t>;
+        using Int64 = Int<int64_t>;
+        using Bool = Int<int32_t>; // 酷Q以 int32 表示布尔值
+
+        // 2 字节长度前缀加 GB18030 编码的字符串, 对应 std::string 成员 (UTF-8)
+        struct String {
+            static constexpr bool VARIABLE = true;
+            static constexpr size_t FIXED_SIZE = sizeof(int16_t);
+        };
+
+        // 2 字节长度前缀加原样保存的字节串, 对应 std::string 成员
+        struct Bytes {
+            static constexpr bool VARIABLE = true;
+            static constexpr size_t FIXED_SIZE = sizeof(int16_t);
+        };
+    } // namespace wire
+
+    // 把数据对象的成员 Member 与其存储格式 Wire 对应起来
+    template <auto Member, typename Wire>
+    struct Field {
+        static constexpr auto member = Member;
+        using wire = Wire;
+    };
+
+    template <typename IntType>
+    inline void _append_big_endian(std::string &out, const IntType value) {
+        using UInt = std::make_unsigned_t<IntType>;
+        const auto raw = _bswap(static_cast<UInt>(value));
+        char bytes[sizeof(raw)];
+        std::memcpy(bytes, &raw, sizeof(raw));
+        out.append(bytes, sizeof(raw));
+    }
+
+    // 合法的 GB18030 字符串 gb 中不超过 max_size 字节且不切开字符的最长前缀的长度;
+    // 首字节为 0x81-0xFE 时, 第二字节为 0x30-0x39 则为四字节字符, 否则为双字节字符
+    inline size_t _gb18030_prefix_size(const std::string_view gb, const size_t max_size) {
+        size_t size = 0;
+        while (size < gb.size()) {
+            const auto lead = static_cast<uint8_t>(gb[size]);
+            size_t len = 1;
+            if (lead >= 0x80 && size + 1 < gb.size()) {
+                const auto second = static_cast<uint8_t>(gb[size + 1]);
+                len = second >= 0x30 && second <= 0x39 ? 4 : 2;
+            }
+            if (size + len > max_size) break;
+            size += len;
+        }
+        return size;
+    }
+
+    // 按字段顺序描述 T 的二进制格式, 生成对应的解码和编码函数.
+    // 解码时先检查一次所有定长部分是否足够, 之后只在每个变长字段处检查一次, 定长字段直接读取
+    template <typename T, typename... Fields>
+    class BinSchema {
+    public:
+        // 所有字段都为空字符串时的字节数
+        static constexpr size_t MIN_SIZE = (Fields::wire::FIXED_SIZE + ... + 0);
+
+        // 从 bytes 开头解析 obj 的各字段, 成功时 bytes 变为剩余的数据;
+        // 数据不足时返回 false, 不修改 bytes, obj 中可能已有部分字段被赋值
+        static bool decode(std::string_view &bytes, T &obj) {
+            if (bytes.size() < MIN_SIZE) return false;
+            auto p = bytes.data();
+            const auto end = p + bytes.size();
+            if (!decode_fields(p, end, obj, std::index_sequence_for<Fields...>{})) return false;
+            bytes.remove_prefix(static_cast<size_t>(p - bytes.data()));
+            return true;
+        }
+
+        // 解析整个对象, 数据不足时返回 std::nullopt
+        static std::optional<T> try_decode(std::string_view bytes) {
+            T obj;
+            if (!decode(bytes, obj)) return std::nullopt;
+            return obj;
+        }
+
+        // 编码后追加到 out; 超过 65535 字节的字段会被截断, wire::String 在完整的字符处截断
+        static void encode_to(std::string &out, const T &obj) {
+            (encode_field<Fields>(out, obj), ...);
+        }
+
+        static std::string encode(const T &obj) {
+            std::string out;
+            out.reserve(MIN_SIZE);
+            encode_to(out, obj);
+            return out;
+        }
+
+    private:
+        // FIXED_AFTER[i] 为第 i 个及之后的字段的定长部分之和
+        static constexpr std::array<size_t, sizeof...(Fields) + 1> FIXED_AFTER = [] {
+            std::array<size_t, sizeof...(Fields) + 1> sizes{};
+            constexpr size_t fixed[] = {Fields::wire::FIXED_SIZE..., 0};
+            for (auto i = sizeof...(Fields); i > 0; i--) sizes[i - 1] = sizes[i] + fixed[i - 1];
+            return sizes;
+        }();
+
+        template <size_t... I>
+        static bool decode_fields(const char *&p, const char *end, T &obj, std::index_sequence<I...>) {
+            return (decode_field<I, Fields>(p, end, obj) && ...);
+        }
+
+        template <size_t I, typename F>
+        static bool decode_field(const char *&p, const char *end, T &obj) {
+            using Wire = typename F::wire;
+            auto &member = obj.*(F::member);
+            using Member = std::remove_reference_t<decltype(member)>;
+
+            if constexpr (!Wire::VARIABLE) {
+                // 已由之前的检查保证足够
+                member = static_cast<Member>(_read_big_endian<typename Wire::type>(p));
+                p += Wire::FIXED_SIZE;
+            } else {
+                const auto len = static_cast<uint16_t>(_read_big_endian<int16_t>(p));
+                p += Wire::FIXED_SIZE;
+                if (static_cast<size_t>(end - p) < len + FIXED_AFTER[I + 1]) return false;
+                if constexpr (std::is_same_v<Wire, wire::String>) {
+                    member = len == 0 ? std::string() : string_from_coolq(std::string_view(p, len));
+                } else {
+                    member.assign(p, len);
+                }
+                p += len;
+            }
+            return true;
+        }
+
+        template <typename F>
+        static void encode_field(std::string &out, const T &obj) {
+            using Wire = typename F::wire;
+            const auto &member = obj.*(F::member);
+
+            if constexpr (!Wire::VARIABLE) {
+                _append_big_endian(out, static_cast<typename Wire::type>(member));
+            } else {
+                // wire::Bytes 直接写入成员, 不复制
+                std::string converted;
+                std::string_view bytes = member;
+                if constexpr (std::is_same_v<Wire, wire::String>) {
+                    converted = string_to_coolq(member);
+                    bytes = converted;
+                }
+                auto len = static_cast<uint16_t>(std::min<size_t>(bytes.size(), UINT16_MAX));
+                if constexpr (std::is_same_v<Wire, wire::String>) {
+                    if (bytes.size() > UINT16_MAX) len = static_cast<uint16_t>(_gb18030_prefix_size(bytes, UINT16_MAX));
+                }
+                _append_big_endian(out, static_cast<int16_t>(len));
+                out.append(bytes.data(), len);
+            }
+        }
+    };
+} // namespace cq::utils
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "small_vector.hpp"
+
+namespace cq::utils {
+    // 以有序连续数组实现的关联容器, 键的遍历顺序与 std::map 相同, 元素个数不超过 N 时不进行堆内存分配;
+    // 查找支持与键类型可比较的任意类型 (如 std::string_view), 插入和删除会使迭代器失效
+    template <typename Key, typename Value, size_t N>
+    class FlatMap {
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using container_type = SmallVector<value_type, N>;
+        using size_type = typename container_type::size_type;
+        using iterator = typename container_type::iterator;
+        using const_iterator = typename container_type::const_iterator;
+        using key_compare = std::less<>;
+
+        FlatMap() = default;
+
+        template <typename InputIt>
+        FlatMap(InputIt first, InputIt last) {
+            for (; first != last; ++first) emplace(first->first, first->second);
+        }
+
+        FlatMap(std::initializer_list<value_type> init) : FlatMap(init.begin(), init.end()) {
+        }
+
+        iterator begin() noexcept {
+            return items_.begin();
+        }
+
+        const_iterator begin() const noexcept {
+            return items_.begin();
+        }
+
+        const_iterator cbegin() const noexcept {
+            return items_.cbegin();
+        }
+
+        iterator end() noexcept {
+            return items_.end();
+        }
+
+        const_iterator end() const noexcept {
+            return items_.end();
+        }
+
+        const_iterator cend() const noexcept {
+            return items_.cend();
+        }
+
+        bool empty() const noexcept {
+            return items_.empty();
+        }
+
+        size_type size() const noexcept {
+            return items_.size();
+        }
+
+        void clear() noexcept {
+            items_.clear();
+        }
+
+        void reserve(const size_type new_cap) {
+            items_.reserve(new_cap);
+        }
+
+        template <typename K>
+        iterator lower_bound(const K &key) {
+            return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+        }
+
+        template <typename K>
+        const_iterator lower_bound(const K &key) const {
+            return std::lower_bound(items_.begin(), items_.end(), key, KeyLess());
+        }
+
+        template <typename K>
+        iterator find(const K &key) {
+            const auto it = lower_bound(key);
+            return it != end() && !key_compare()(key, it->first) ? it : end();
+        }
+
+        template <typename K>
+        const_iterator find(const K &key) const {
+            const auto it = lower_bound(key);
+            return it != end() && !key_compare()(key, it->first) ? it : end();
+        }
+
+        template <typename K>
+        size_type count(const K &key) const {
+            return find(key) != end() ? 1 : 0;
+        }
+
+        template <typename K>
+        bool contains(const K &key) const {
+            return find(key) != end();
+        }
+
+        template <typename K>
+        Value &at(const K &key) {
+            const auto it = find(key);
+            if (it == end()) throw std::out_of_range("FlatMap::at");
+            return it->second;
+        }
+
+        template <typename K>
+        const Value &at(const K &key) const {
+            const auto it = find(key);
+            if (it == end()) throw std::out_of_range("FlatMap::at");
+            return it->second;
+        }
+
+        Value &operator[](const Key &key) {
+            return try_emplace(key).first->second;
+        }
+
+        Value &operator[](Key &&key) {
+            return try_emplace(std::move(key)).first->second;
+        }
+
+        // 键不存在时插入, 已存在时不做任何修改, 与 std::map::try_emplace 相同
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> try_emplace(K &&key, Args &&... args) {
+            const auto it = lower_bound(key);
+            if (it != end() && !key_compare()(key, it->first)) return {it, false};
+            const auto pos = items_.emplace(it,
+                                            std::piecewise_construct,
+                                            std::forward_as_tuple(std::forward<K>(key)),
+                                            std::forward_as_tuple(std::forward<Args>(args)...));
+            return {pos, true};
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> emplace(K &&key, V &&value) {
+            return try_emplace(std::forward<K>(key), std::forward<V>(value));
+        }
+
+        std::pair<iterator, bool> insert(const value_type &value) {
+            return try_emplace(value.first, value.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type &&value) {
+            return try_emplace(std::move(value.first), std::move(value.second));
+        }
+
+        template <typename K, typename V>
+        std::pair<iterator, bool> insert_or_assign(K &&key, V &&value) {
+            auto res = try_emplace(std::forward<K>(key), std::forward<V>(value));
+            if (!res.second) res.first->second = std::forward<V>(value);
+            return res;
+        }
+
+        iterator erase(const_iterator pos) {
+            return items_.erase(pos);
+        }
+
+        template <typename K, typename = std::enable_if_t<!std::is_convertible_v<const K &, const_iterator>>>
+        size_type erase(const K &key) {
+            const auto it = find(key);
+            if (it == end()) return 0;
+            items_.erase(it);
+            return 1;
+        }
+
+        friend bool operator==(const FlatMap &lhs, const FlatMap &rhs) {
+            return lhs.items_ == rhs.items_;
+        }
+
+        friend bool operator!=(const FlatMap &lhs, const FlatMap &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const FlatMap &lhs, const FlatMap &rhs) {
+            return lhs.items_ < rhs.items_;
+        }
+
+    private:
+        struct KeyLess {
+            template <typename K>
+            bool operator()(const value_type &item, const K &key) const {
+                return key_compare()(item.first, key);
+            }
+        };
+
+        container_type items_;
+    };
+} // namespace cq::utils
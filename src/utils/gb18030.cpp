@@ -0,0 +1,183 @@
+#include "gb18030.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "gb18030_table.hpp"
+#include "simd.hpp"
+#include "unicode.hpp"
+
+namespace cq::utils {
+    // 0x90308130 的线性序号, 其后依次对应 U+10000 至 U+10FFFF
+    static constexpr uint32_t GB18030_SUPPLEMENTARY_LINEAR = (0x90 - 0x81) * 12600;
+
+    static size_t _two_byte_index(const uint8_t lead, const uint8_t trail) {
+        return (lead - 0x81) * GB18030_TWO_BYTE_TRAIL_COUNT + (trail < 0x7F ? trail - 0x40 : trail - 0x41);
+    }
+
+    // BMP 码位到双字节编码的反向映射, 0 表示该码位使用单字节或四字节编码; 首次使用时由正向映射生成
+    static const std::array<uint16_t, 0x10000> &_two_byte_reverse_table() {
+        static const auto table = [] {
+            auto t = std::make_unique<std::array<uint16_t, 0x10000>>();
+            t->fill(0);
+            for (uint32_t lead = 0x81; lead <= 0xFE; lead++) {
+                for (uint32_t trail = 0x40; trail <= 0xFE; trail++) {
+                    if (trail == 0x7F) continue;
+                    const auto cp = GB18030_TWO_BYTE_TABLE[_two_byte_index(lead, trail)];
+                    (*t)[cp] = static_cast<uint16_t>(lead << 8 | trail);
+                }
+            }
+            return t;
+        }();
+        return *table;
+    }
+
+    // 解出 in 开头的一个非 ASCII 的 GB18030 字符, 返回码位并设置 len 为其字节数;
+    // 非法或未分配时返回 REPLACEMENT_CHARACTER, len 为 1, 以免吞掉之后的有效字符
+    static uint32_t _decode_gb18030(const uint8_t *in, const size_t n, size_t &len) {
+        len = 1;
+        const auto b1 = in[0];
+        if (b1 == 0x80 || b1 == 0xFF || n < 2) return REPLACEMENT_CHARACTER;
+
+        const auto b2 = in[1];
+        if (b2 >= 0x40 && b2 <= 0xFE && b2 != 0x7F) {
+            len = 2;
+            return GB18030_TWO_BYTE_TABLE[_two_byte_index(b1, b2)];
+        }
+        if (b2 < 0x30 || b2 > 0x39 || n < 4) return REPLACEMENT_CHARACTER;
+        const auto b3 = in[2], b4 = in[3];
+        if (b3 < 0x81 || b3 > 0xFE || b4 < 0x30 || b4 > 0x39) return REPLACEMENT_CHARACTER;
+
+        const auto linear =
+            static_cast<uint32_t>((b1 - 0x81) * 12600 + (b2 - 0x30) * 1260 + (b3 - 0x81) * 10 + (b4 - 0x30));
+        if (linear < GB18030_BMP_LINEAR_COUNT) {
+            const auto range = std::upper_bound(std::begin(GB18030_FOUR_BYTE_RANGES),
+                                                std::end(GB18030_FOUR_BYTE_RANGES),
+                                                linear,
+                                                [](const uint32_t l, const Gb18030Range &r) { return l < r.linear; })
+                               - 1;
+            len = 4;
+            return range->code_point + (linear - range->linear);
+        }
+        if (linear >= GB18030_SUPPLEMENTARY_LINEAR && linear - GB18030_SUPPLEMENTARY_LINEAR < 0x100000) {
+            len = 4;
+            return 0x10000 + (linear - GB18030_SUPPLEMENTARY_LINEAR);
+        }
+        return REPLACEMENT_CHARACTER;
+    }
+
+    static char *_put_gb18030(char *dst, const uint32_t cp) {
+        uint32_t linear;
+        if (cp < 0x10000) {
+            if (const auto two = _two_byte_reverse_table()[cp]) {
+                *dst++ = static_cast<char>(two >> 8);
+                *dst++ = static_cast<char>(two & 0xFF);
+                return dst;
+            }
+            const auto range = std::upper_bound(std::begin(GB18030_FOUR_BYTE_RANGES),
+                                                std::end(GB18030_FOUR_BYTE_RANGES),
+                                                cp,
+                                                [](const uint32_t c, const Gb18030Range &r) { return c < r.code_point; })
+                               - 1;
+            linear = range->linear + (cp - range->code_point);
+        } else {
+            linear = GB18030_SUPPLEMENTARY_LINEAR + (cp - 0x10000);
+        }
+        *dst++ = static_cast<char>(0x81 + linear / 12600);
+        *dst++ = static_cast<char>(0x30 + linear / 1260 % 10);
+        *dst++ = static_cast<char>(0x81 + linear / 10 % 126);
+        *dst++ = static_cast<char>(0x30 + linear % 10);
+        return dst;
+    }
+
+    size_t gb18030_code_point_size(const uint32_t cp) {
+        if (cp < 0x80) return 1;
+        if (cp < 0x10000 && _two_byte_reverse_table()[cp]) return 2;
+        return 4;
+    }
+
+    size_t gb18030_size(const std::string_view utf8) {
+        size_t size = 0;
+        auto in = utf8.data();
+        const auto end = in + utf8.size();
+        while (in != end) {
+            const auto ascii_end = simd::find_non_ascii(in, end);
+            size += static_cast<size_t>(ascii_end - in);
+            in = ascii_end;
+            if (in == end) break;
+
+            size_t len;
+            const auto cp = _decode_utf8(reinterpret_cast<const uint8_t *>(in), static_cast<size_t>(end - in), len);
+            size += cp == REPLACEMENT_CHARACTER && len == 1 ? 1 : gb18030_code_point_size(cp);
+            in += len;
+        }
+        return size;
+    }
+
+    // n 字节合法的 GB18030 转换为 UTF-8 后的最大字节数: 双字节字符最多变为 3 字节, 四字节字符最多变为 4 字节;
+    // 只有单个非法字节 (变为 3 字节的 U+FFFD) 可能超出, 需另外处理
+    static size_t _utf8_size_bound(const size_t n) {
+        return n / 2 * 3 + n % 2;
+    }
+
+    void gb18030_to_utf8_to(std::string &out, const std::string_view gb) {
+        const auto old_size = out.size();
+        out.resize(old_size + _utf8_size_bound(gb.size()));
+        auto dst = &out[old_size];
+
+        auto in = gb.data();
+        const auto end = in + gb.size();
+        while (in != end) {
+            const auto ascii_end = simd::find_non_ascii(in, end);
+            std::memcpy(dst, in, static_cast<size_t>(ascii_end - in));
+            dst += ascii_end - in;
+            in = ascii_end;
+            if (in == end) break;
+
+            size_t len;
+            const auto cp = _decode_gb18030(reinterpret_cast<const uint8_t *>(in), static_cast<size_t>(end - in), len);
+            if (len == 1) {
+                // 非法字节可能让结果超出预留的空间, 此时扩充
+                const auto written = static_cast<size_t>(dst - &out[0]);
+                const auto needed = written + 3 + _utf8_size_bound(static_cast<size_t>(end - in - 1));
+                if (needed > out.size()) {
+                    out.resize(needed);
+                    dst = &out[written];
+                }
+            }
+            dst = _put_utf8(dst, cp);
+            in += len;
+        }
+        out.resize(static_cast<size_t>(dst - &out[0]));
+    }
+
+    void utf8_to_gb18030_to(std::string &out, const std::string_view utf8) {
+        // 2 字节的 UTF-8 字符最多变为 4 字节, 其余字符不会变长
+        const auto old_size = out.size();
+        out.resize(old_size + utf8.size() * 2);
+        auto dst = &out[old_size];
+
+        auto in = utf8.data();
+        const auto end = in + utf8.size();
+        while (in != end) {
+            const auto ascii_end = simd::find_non_ascii(in, end);
+            std::memcpy(dst, in, static_cast<size_t>(ascii_end - in));
+            dst += ascii_end - in;
+            in = ascii_end;
+            if (in == end) break;
+
+            size_t len;
+            const auto cp = _decode_utf8(reinterpret_cast<const uint8_t *>(in), static_cast<size_t>(end - in), len);
+            if (cp == REPLACEMENT_CHARACTER && len == 1) {
+                *dst++ = '?';
+            } else {
+                dst = _put_gb18030(dst, cp);
+            }
+            in += len;
+        }
+        out.resize(static_cast<size_t>(dst - &out[0]));
+    }
+} // namespace cq::utils
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cq::utils {
+    // GB18030 与 UTF-8 之间的转换, 不依赖 iconv 或系统 API, 各平台结果一致.
+    // 输出按最坏情况一次分配, 不会因空间不足而失败; ASCII 部分整段复制
+
+    // 将 GB18030 字符串转换为 UTF-8 后追加到 out, 非法或未分配的字节替换为 U+FFFD
+    void gb18030_to_utf8_to(std::string &out, std::string_view gb);
+
+    // 将 UTF-8 字符串转换为 GB18030 后追加到 out, 非法的 UTF-8 字节替换为 '?'
+    void utf8_to_gb18030_to(std::string &out, std::string_view utf8);
+
+    // 码位 cp 在 GB18030 编码下的字节数 (1, 2 或 4)
+    size_t gb18030_code_point_size(uint32_t cp);
+
+    // UTF-8 字符串转换为 GB18030 后的字节数, 与 utf8_to_gb18030_to 的输出长度一致, 但不实际转换
+    size_t gb18030_size(std::string_view utf8);
+
+    inline std::string gb18030_to_utf8(const std::string_view gb) {
+        std::string out;
+        gb18030_to_utf8_to(out, gb);
+        return out;
+    }
+
+    inline std::string utf8_to_gb18030(const std::string_view utf8) {
+        std::string out;
+        utf8_to_gb18030_to(out, utf8);
+        return out;
+    }
+} // namespace cq::utils
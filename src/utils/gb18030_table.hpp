@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cq::utils {
+    // 双字节编码的首字节为 0x81-0xFE, 尾字节为 0x40-0x7E 或 0x80-0xFE
+    constexpr size_t GB18030_TWO_BYTE_TRAIL_COUNT = 190;
+    constexpr size_t GB18030_TWO_BYTE_COUNT = 126 * GB18030_TWO_BYTE_TRAIL_COUNT;
+
+    // 双字节编码到 Unicode 码位 (均在 BMP 内) 的映射,
+    // 下标为 (首字节 - 0x81) * 190 + 尾字节在 0x40-0x7E, 0x80-0xFE 中的序号
+    extern const uint16_t GB18030_TWO_BYTE_TABLE[GB18030_TWO_BYTE_COUNT];
+
+    // BMP 内的四字节编码按其线性序号 (0x81308130 为 0) 依次对应其余的码位, 分为若干连续区间,
+    // 每个区间记录起始的线性序号和码位, 两者都递增
+    struct Gb18030Range {
+        uint16_t linear;
+        uint16_t code_point;
+    };
+
+    constexpr size_t GB18030_FOUR_BYTE_RANGE_COUNT = 206;
+    constexpr uint32_t GB18030_BMP_LINEAR_COUNT = 39420;
+    extern const Gb18030Range GB18030_FOUR_BYTE_RANGES[GB18030_FOUR_BYTE_RANGE_COUNT];
+} // namespace cq::utils
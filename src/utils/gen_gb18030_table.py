@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""
+根据 Python 内置的 gb18030 编解码器生成 gb18030_table.cpp.
+
+用法: python3 gen_gb18030_table.py > gb18030_table.cpp
+"""
+
+TWO_BYTE_TRAILS = list(range(0x40, 0x7F)) + list(range(0x80, 0xFF))
+
+
+def four_byte_linear_to_bytes(linear):
+    b1, r = divmod(linear, 12600)
+    b2, r = divmod(r, 1260)
+    b3, b4 = divmod(r, 10)
+    return bytes([0x81 + b1, 0x30 + b2, 0x81 + b3, 0x30 + b4])
+
+
+def main():
+    two_byte = []
+    for lead in range(0x81, 0xFF):
+        for trail in TWO_BYTE_TRAILS:
+            ch = bytes([lead, trail]).decode('gb18030')
+            assert len(ch) == 1
+            two_byte.append(ord(ch))
+
+    # 四字节编码 0x81308130 至 0x8431A439 按顺序对应 BMP 中其余的码位, 分为若干连续的区间
+    ranges = []
+    prev = None
+    for linear in range(39420):
+        cp = ord(four_byte_linear_to_bytes(linear).decode('gb18030'))
+        if prev is None or cp != prev + 1:
+            ranges.append((linear, cp))
+        prev = cp
+
+    print('// 由 gen_gb18030_table.py 生成, 请勿手动修改')
+    print()
+    print('#include "gb18030_table.hpp"')
+    print()
+    print('namespace cq::utils {')
+    print('    const uint16_t GB18030_TWO_BYTE_TABLE[GB18030_TWO_BYTE_COUNT] = {')
+    for i in range(0, len(two_byte), 12):
+        print('        ' + ' '.join('0x%04X,' % cp for cp in two_byte[i:i + 12]))
+    print('    };')
+    print()
+    print('    const Gb18030Range GB18030_FOUR_BYTE_RANGES[GB18030_FOUR_BYTE_RANGE_COUNT] = {')
+    for i in range(0, len(ranges), 4):
+        print('        ' + ' '.join('{%d, 0x%04X},' % r for r in ranges[i:i + 4]))
+    print('    };')
+    print('} // namespace cq::utils')
+
+    assert len(two_byte) == 23940 and len(ranges) == 206, (len(two_byte), len(ranges))
+
+
+if __name__ == '__main__':
+    main()
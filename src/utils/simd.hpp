@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CQ_SIMD_X86 1 // 可以使用 SSE2, 更高的指令集需要在运行时检测
+#endif
+#endif
+
+#ifdef CQ_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(CQ_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define CQ_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CQ_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CQ_TARGET_SSSE3
+#define CQ_TARGET_AVX2
+#endif
+
+namespace cq::utils::simd {
+    inline unsigned count_trailing_zeros(const uint32_t x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(x));
+#elif defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, x);
+        return static_cast<unsigned>(index);
+#else
+        unsigned n = 0;
+        while (!(x & (1u << n))) n++;
+        return n;
+#endif
+    }
+
+#ifdef CQ_SIMD_X86
+    struct CpuFeatures {
+        bool ssse3 = false;
+        bool avx2 = false;
+    };
+
+    // 运行时检测 CPU (及操作系统) 支持的指令集, 结果在首次调用时缓存
+    inline const CpuFeatures &cpu_features() noexcept {
+        static const CpuFeatures features = [] {
+            CpuFeatures f;
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_cpu_init();
+            f.ssse3 = __builtin_cpu_supports("ssse3");
+            f.avx2 = __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            const auto max_leaf = info[0];
+            __cpuid(info, 1);
+            f.ssse3 = (info[2] & (1 << 9)) != 0;
+            const bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+            if (max_leaf >= 7 && os_saves_ymm) {
+                __cpuidex(info, 7, 0);
+                f.avx2 = (info[1] & (1 << 5)) != 0;
+            }
+#endif
+            return f;
+        }();
+        return features;
+    }
+#endif
+
+    inline const char *_find_any_of_scalar(const char *first, const char *last, const char c0, const char c1,
+                                           const char c2, const char c3) noexcept {
+        for (; first != last; ++first) {
+            const auto ch = *first;
+            if (ch == c0 || ch == c1 || ch == c2 || ch == c3) break;
+        }
+        return first;
+    }
+
+#ifdef CQ_SIMD_X86
+    inline const char *_find_any_of_sse2(const char *first, const char *last, const char c0, const char c1,
+                                         const char c2, const char c3) noexcept {
+        const auto v0 = _mm_set1_epi8(c0), v1 = _mm_set1_epi8(c1), v2 = _mm_set1_epi8(c2), v3 = _mm_set1_epi8(c3);
+        for (; last - first >= 16; first += 16) {
+            const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            const auto eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(x, v0), _mm_cmpeq_epi8(x, v1)),
+                                         _mm_or_si128(_mm_cmpeq_epi8(x, v2), _mm_cmpeq_epi8(x, v3)));
+            if (const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(eq))) {
+                return first + count_trailing_zeros(mask);
+            }
+        }
+        return _find_any_of_scalar(first, last, c0, c1, c2, c3);
+    }
+
+    CQ_TARGET_AVX2 inline const char *_find_any_of_avx2(const char *first, const char *last, const char c0,
+                                                        const char c1, const char c2, const char c3) noexcept {
+        const auto v0 = _mm256_set1_epi8(c0), v1 = _mm256_set1_epi8(c1);
+        const auto v2 = _mm256_set1_epi8(c2), v3 = _mm256_set1_epi8(c3);
+        for (; last - first >= 32; first += 32) {
+            const auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            const auto eq = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(x, v0), _mm256_cmpeq_epi8(x, v1)),
+                                            _mm256_or_si256(_mm256_cmpeq_epi8(x, v2), _mm256_cmpeq_epi8(x, v3)));
+            if (const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq))) {
+                return first + count_trailing_zeros(mask);
+            }
+        }
+        return _find_any_of_sse2(first, last, c0, c1, c2, c3);
+    }
+#endif
+
+    // 返回 [first, last) 中第一个等于 c0, c1, c2, c3 之一的字符的位置, 不存在时返回 last;
+    // x86 下使用 SSE2, CPU 支持时使用 AVX2, 其它平台使用逐字节比较
+    inline const char *find_any_of(const char *first, const char *last, const char c0, const char c1, const char c2,
+                                   const char c3) noexcept {
+#ifdef CQ_SIMD_X86
+        if (last - first >= 32 && cpu_features().avx2) return _find_any_of_avx2(first, last, c0, c1, c2, c3);
+        return _find_any_of_sse2(first, last, c0, c1, c2, c3);
+#else
+        return _find_any_of_scalar(first, last, c0, c1, c2, c3);
+#endif
+    }
+
+    inline const char *_find_non_ascii_scalar(const char *first, const char *last) noexcept {
+        while (first != last && static_cast<unsigned char>(*first) < 0x80) ++first;
+        return first;
+    }
+
+#ifdef CQ_SIMD_X86
+    inline const char *_find_non_ascii_sse2(const char *first, const char *last) noexcept {
+        for (; last - first >= 16; first += 16) {
+            const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            if (const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(x))) {
+                return first + count_trailing_zeros(mask);
+            }
+        }
+        return _find_non_ascii_scalar(first, last);
+    }
+#endif
+
+    // 返回 [first, last) 中第一个非 ASCII 字节 (最高位为 1) 的位置, 不存在时返回 last
+    inline const char *find_non_ascii(const char *first, const char *last) noexcept {
+#ifdef CQ_SIMD_X86
+        return _find_non_ascii_sse2(first, last);
+#else
+        return _find_non_ascii_scalar(first, last);
+#endif
+    }
+} // namespace cq::utils::simd
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace cq::utils {
+    // 带有内联存储的连续容器, 元素个数不超过 N 时不进行堆内存分配, 接口与 std::vector 保持一致
+    template <typename T, size_t N>
+    class SmallVector {
+        static_assert(N > 0, "inline capacity of SmallVector must be positive");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using iterator = T *;
+        using const_iterator = const T *;
+        using reverse_iterator = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static constexpr size_type inline_capacity = N;
+
+        SmallVector() noexcept : data_(inline_data()), size_(0), capacity_(N) {
+        }
+
+        explicit SmallVector(const size_type count) : SmallVector() {
+            resize(count);
+        }
+
+        SmallVector(const size_type count, const T &value) : SmallVector() {
+            assign(count, value);
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        SmallVector(InputIt first, InputIt last) : SmallVector() {
+            assign(first, last);
+        }
+
+        SmallVector(std::initializer_list<T> init) : SmallVector(init.begin(), init.end()) {
+        }
+
+        SmallVector(const SmallVector &other) : SmallVector(other.begin(), other.end()) {
+        }
+
+        SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) : SmallVector() {
+            steal(std::move(other));
+        }
+
+        ~SmallVector() {
+            clear();
+            release();
+        }
+
+        SmallVector &operator=(const SmallVector &other) {
+            if (this != &other) assign(other.begin(), other.end());
+            return *this;
+        }
+
+        SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this != &other) {
+                clear();
+                release();
+                steal(std::move(other));
+            }
+            return *this;
+        }
+
+        SmallVector &operator=(std::initializer_list<T> init) {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        void assign(const size_type count, const T &value) {
+            clear();
+            reserve(count);
+            std::uninitialized_fill_n(data_, count, value);
+            size_ = count;
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        void assign(InputIt first, InputIt last) {
+            clear();
+            insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<T> init) {
+            assign(init.begin(), init.end());
+        }
+
+        reference at(const size_type pos) {
+            if (pos >= size_) throw std::out_of_range("SmallVector::at");
+            return data_[pos];
+        }
+
+        const_reference at(const size_type pos) const {
+            if (pos >= size_) throw std::out_of_range("SmallVector::at");
+            return data_[pos];
+        }
+
+        reference operator[](const size_type pos) {
+            return data_[pos];
+        }
+
+        const_reference operator[](const size_type pos) const {
+            return data_[pos];
+        }
+
+        reference front() {
+            return data_[0];
+        }
+
+        const_reference front() const {
+            return data_[0];
+        }
+
+        reference back() {
+            return data_[size_ - 1];
+        }
+
+        const_reference back() const {
+            return data_[size_ - 1];
+        }
+
+        T *data() noexcept {
+            return data_;
+        }
+
+        const T *data() const noexcept {
+            return data_;
+        }
+
+        iterator begin() noexcept {
+            return data_;
+        }
+
+        const_iterator begin() const noexcept {
+            return data_;
+        }
+
+        const_iterator cbegin() const noexcept {
+            return data_;
+        }
+
+        iterator end() noexcept {
+            return data_ + size_;
+        }
+
+        const_iterator end() const noexcept {
+            return data_ + size_;
+        }
+
+        const_iterator cend() const noexcept {
+            return data_ + size_;
+        }
+
+        reverse_iterator rbegin() noexcept {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator rbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator crbegin() const noexcept {
+            return const_reverse_iterator(end());
+        }
+
+        reverse_iterator rend() noexcept {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator rend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator crend() const noexcept {
+            return const_reverse_iterator(begin());
+        }
+
+        bool empty() const noexcept {
+            return size_ == 0;
+        }
+
+        size_type size() const noexcept {
+            return size_;
+        }
+
+        size_type max_size() const noexcept {
+            return std::allocator_traits<std::allocator<T>>::max_size(std::allocator<T>());
+        }
+
+        size_type capacity() const noexcept {
+            return capacity_;
+        }
+
+        // 是否仍在使用内联存储
+        bool is_inline() const noexcept {
+            return data_ == inline_data();
+        }
+
+        void reserve(const size_type new_cap) {
+            if (new_cap > capacity_) reallocate(new_cap);
+        }
+
+        void shrink_to_fit() {
+            if (is_inline() || size_ == capacity_) return;
+            if (size_ <= N) {
+                T *old_data = data_;
+                const auto old_cap = capacity_;
+                std::uninitialized_move(old_data, old_data + size_, inline_data());
+                std::destroy(old_data, old_data + size_);
+                std::allocator<T>().deallocate(old_data, old_cap);
+                data_ = inline_data();
+                capacity_ = N;
+            } else {
+                reallocate(size_);
+            }
+        }
+
+        void clear() noexcept {
+            std::destroy(data_, data_ + size_);
+            size_ = 0;
+        }
+
+        iterator insert(const_iterator pos, const T &value) {
+            return emplace(pos, value);
+        }
+
+        iterator insert(const_iterator pos, T &&value) {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator insert(const_iterator pos, const size_type count, const T &value) {
+            const auto index = pos - begin();
+            const auto old_size = size_;
+            for (size_type i = 0; i < count; i++) emplace_back(value);
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        iterator insert(const_iterator pos, InputIt first, InputIt last) {
+            const auto index = pos - begin();
+            const auto old_size = size_;
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                            typename std::iterator_traits<InputIt>::iterator_category>) {
+                const auto count = static_cast<size_type>(std::distance(first, last));
+                if (size_ + count > capacity_) {
+                    // 与 emplace_back 相同, 先复制新元素再移动旧元素, 以支持插入自身元素的情况
+                    const auto new_cap = grown_capacity(size_ + count);
+                    T *new_data = std::allocator<T>().allocate(new_cap);
+                    try {
+                        std::uninitialized_copy(first, last, new_data + size_);
+                    } catch (...) {
+                        std::allocator<T>().deallocate(new_data, new_cap);
+                        throw;
+                    }
+                    std::uninitialized_move(data_, data_ + size_, new_data);
+                    std::destroy(data_, data_ + size_);
+                    release();
+                    data_ = new_data;
+                    capacity_ = new_cap;
+                } else {
+                    std::uninitialized_copy(first, last, data_ + size_);
+                }
+                size_ += count;
+            } else {
+                for (; first != last; ++first) emplace_back(*first);
+            }
+            std::rotate(begin() + index, begin() + old_size, end());
+            return begin() + index;
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> init) {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        template <typename... Args>
+        iterator emplace(const_iterator pos, Args &&... args) {
+            const auto index = pos - begin();
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + index, end() - 1, end());
+            return begin() + index;
+        }
+
+        iterator erase(const_iterator pos) {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const auto first_it = begin() + (first - cbegin());
+            const auto last_it = begin() + (last - cbegin());
+            if (first_it != last_it) {
+                const auto new_end = std::move(last_it, end(), first_it);
+                std::destroy(new_end, end());
+                size_ = new_end - begin();
+            }
+            return first_it;
+        }
+
+        void push_back(const T &value) {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value) {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        reference emplace_back(Args &&... args) {
+            if (size_ == capacity_) {
+                // 先在新存储上构造新元素, 以支持参数引用自身元素的情况
+                const auto new_cap = grown_capacity(size_ + 1);
+                T *new_data = std::allocator<T>().allocate(new_cap);
+                try {
+                    ::new (static_cast<void *>(new_data + size_)) T(std::forward<Args>(args)...);
+                } catch (...) {
+                    std::allocator<T>().deallocate(new_data, new_cap);
+                    throw;
+                }
+                std::uninitialized_move(data_, data_ + size_, new_data);
+                std::destroy(data_, data_ + size_);
+                release();
+                data_ = new_data;
+                capacity_ = new_cap;
+            } else {
+                ::new (static_cast<void *>(data_ + size_)) T(std::forward<Args>(args)...);
+            }
+            return data_[size_++];
+        }
+
+        void pop_back() {
+            std::destroy_at(data_ + --size_);
+        }
+
+        void resize(const size_type count) {
+            if (count < size_) {
+                erase(begin() + count, end());
+            } else {
+                reserve(count);
+                std::uninitialized_value_construct(data_ + size_, data_ + count);
+                size_ = count;
+            }
+        }
+
+        void resize(const size_type count, const value_type &value) {
+            if (count < size_) {
+                erase(begin() + count, end());
+            } else {
+                while (size_ < count) emplace_back(value);
+            }
+        }
+
+        void swap(SmallVector &other) {
+            SmallVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
+
+    private:
+        T *data_;
+        size_type size_;
+        size_type capacity_;
+        alignas(T) unsigned char inline_storage_[sizeof(T) * N];
+
+        T *inline_data() noexcept {
+            return reinterpret_cast<T *>(inline_storage_);
+        }
+
+        const T *inline_data() const noexcept {
+            return reinterpret_cast<const T *>(inline_storage_);
+        }
+
+        size_type grown_capacity(const size_type needed) const noexcept {
+            return std::max(needed, capacity_ * 2);
+        }
+
+        void reallocate(const size_type new_cap) {
+            T *new_data = std::allocator<T>().allocate(new_cap);
+            std::uninitialized_move(data_, data_ + size_, new_data);
+            std::destroy(data_, data_ + size_);
+            release();
+            data_ = new_data;
+            capacity_ = new_cap;
+        }
+
+        // 释放堆存储 (不析构元素)
+        void release() noexcept {
+            if (!is_inline()) {
+                std::allocator<T>().deallocate(data_, capacity_);
+                data_ = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        // 从 other 取得元素, 调用前本对象必须为空且使用内联存储
+        void steal(SmallVector &&other) {
+            if (other.is_inline()) {
+                std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+                size_ = other.size_;
+                other.clear();
+            } else {
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = other.capacity_;
+                other.data_ = other.inline_data();
+                other.size_ = 0;
+                other.capacity_ = N;
+            }
+        }
+    };
+
+    template <typename T, size_t N>
+    inline bool operator==(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <typename T, size_t N>
+    inline bool operator!=(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) {
+        return !(lhs == rhs);
+    }
+
+    template <typename T, size_t N>
+    inline bool operator<(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+} // namespace cq::utils
@@ -10,24 +10,41 @@
 #endif
 
 namespace cq::utils {
+    static bool _encoding_is(const std::string &enc, const std::string_view name) {
+        return std::equal(enc.begin(), enc.end(), name.begin(), name.end(), [](const char a, const char b) {
+            return std::tolower(static_cast<unsigned char>(a)) == b;
+        });
+    }
+
     std::string string_convert_encoding(const std::string &text, const std::string &from_enc, const std::string &to_enc,
                                         float capability_factor) {
+        // GB18030 与 UTF-8 之间的转换使用内置的转换器, 在各模式下都进行实际的转换
+        if (_encoding_is(from_enc, "utf-8") && _encoding_is(to_enc, "gb18030")) return utf8_to_gb18030(text);
+        if (_encoding_is(from_enc, "gb18030") && _encoding_is(to_enc, "utf-8")) return gb18030_to_utf8(text);
+
 #ifdef _CQ_STD_MODE
         // 正在使用 std 模式, 经过酷Q的字符串可使用 libiconv 转码
         using iconv_t = void *;
-        static HMODULE iconv_dll = nullptr;
-        static iconv_t (*iconv_open)(const char *, const char *) = nullptr;
-        static size_t (*iconv)(iconv_t cd, char **, size_t *, char **, size_t *) = nullptr;
-        static int (*iconv_close)(iconv_t) = nullptr;
-
-        if (!iconv_dll) {
-            iconv_dll = LoadLibraryW(L"libiconv.dll");
-            iconv_open =
+        struct Iconv {
+            iconv_t (*open)(const char *, const char *);
+            size_t (*convert)(iconv_t cd, char **, size_t *, char **, size_t *);
+            int (*close)(iconv_t);
+        };
+
+        // 局部静态变量的初始化是线程安全的, 多个线程同时解析数据对象时只加载一次
+        static const auto lib = [] {
+            const auto iconv_dll = LoadLibraryW(L"libiconv.dll");
+            Iconv lib;
+            lib.open =
                 reinterpret_cast<iconv_t (*)(const char *, const char *)>(GetProcAddress(iconv_dll, "libiconv_open"));
-            iconv = reinterpret_cast<size_t (*)(iconv_t cd, char **, size_t *, char **, size_t *)>(
+            lib.convert = reinterpret_cast<size_t (*)(iconv_t cd, char **, size_t *, char **, size_t *)>(
                 GetProcAddress(iconv_dll, "libiconv"));
-            iconv_close = reinterpret_cast<int (*)(iconv_t)>(GetProcAddress(iconv_dll, "libiconv_close"));
-        }
+            lib.close = reinterpret_cast<int (*)(iconv_t)>(GetProcAddress(iconv_dll, "libiconv_close"));
+            return lib;
+        }();
+        const auto iconv_open = lib.open;
+        const auto iconv = lib.convert;
+        const auto iconv_close = lib.close;
 
         std::string result;
 
@@ -2,19 +2,23 @@
 
 #include <algorithm>
 #include <cctype>
-#include <codecvt>
 #include <functional>
 #include <limits>
 #include <locale>
 #include <string>
+#include <string_view>
+
+#include "gb18030.hpp"
+#include "unicode.hpp"
 
 namespace cq::utils {
-    inline std::string ws2s(const std::wstring &ws) {
-        return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>().to_bytes(ws);
+    // wchar_t 字符串 (Windows 下为 UTF-16, 其它平台为 UTF-32) 与 UTF-8 之间的转换, 非法字符替换为 U+FFFD
+    inline std::string ws2s(const std::wstring_view ws) {
+        return wide_to_utf8(ws);
     }
 
-    inline std::wstring s2ws(const std::string &s) {
-        return std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>().from_bytes(s);
+    inline std::wstring s2ws(const std::string_view s) {
+        return utf8_to_wide(s);
     }
 
     std::string ansi(const std::string &s);
@@ -32,12 +36,28 @@ namespace cq::utils {
         return string_convert_encoding(b, encoding, "utf-8", capability_factor);
     }
 
-    inline std::string string_to_coolq(const std::string &str) {
-        return string_encode(str, "gb18030");
+    // 酷Q使用 GB18030 编码, 由内置的转换器处理, 不经过 iconv
+    inline std::string string_to_coolq(const std::string_view str) {
+        return utf8_to_gb18030(str);
+    }
+
+    inline std::string string_from_coolq(const std::string_view str) {
+        return gb18030_to_utf8(str);
     }
 
-    inline std::string string_from_coolq(const std::string &str) {
-        return string_decode(str, "gb18030");
+    // 超过此容量的转换缓冲区在下次使用前释放, 避免偶尔的超长字符串长期占用内存
+    constexpr size_t COOLQ_CSTR_BUFFER_MAX_CAPACITY = 64 * 1024;
+
+    // 将 str 转换为 GB18030 后写入当前线程的第 Slot 个缓冲区, 返回其 C 字符串, 用于直接传给酷Q的 API;
+    // 返回值在当前线程下一次使用同一 Slot 前有效, 同一调用中的多个参数需使用不同的 Slot.
+    // 缓冲区的容量在调用之间复用, 稳定后转换不再分配内存
+    template <size_t Slot = 0>
+    inline const char *string_to_coolq_cstr(const std::string_view str) {
+        thread_local std::string buffer;
+        if (buffer.capacity() > COOLQ_CSTR_BUFFER_MAX_CAPACITY) std::string().swap(buffer);
+        buffer.clear();
+        utf8_to_gb18030_to(buffer, str);
+        return buffer.c_str();
     }
 
     inline void string_replace(std::string &str, const std::string &old_val, const std::string &new_val) {
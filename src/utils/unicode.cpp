@@ -0,0 +1,135 @@
+#include "unicode.hpp"
+
+#include <cstring>
+
+#include "simd.hpp"
+
+namespace cq::utils {
+    template <typename CharT>
+    static constexpr bool IS_UTF16 = sizeof(CharT) == 2;
+
+    // 从 in 开始转换连续的 ASCII 字符, 返回停止处 (第一个非 ASCII 字节或不足一组的剩余部分)
+    template <typename CharT>
+    static const char *_widen_ascii(const char *in, const char *end, CharT *&dst) noexcept {
+#ifdef CQ_SIMD_X86
+        const auto zero = _mm_setzero_si128();
+        for (; end - in >= 16; in += 16) {
+            const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+            if (_mm_movemask_epi8(x)) break;
+            const auto lo = _mm_unpacklo_epi8(x, zero), hi = _mm_unpackhi_epi8(x, zero);
+            if constexpr (IS_UTF16<CharT>) {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), lo);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8), hi);
+            } else {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 12), _mm_unpackhi_epi16(hi, zero));
+            }
+            dst += 16;
+        }
+#endif
+        for (; in != end && static_cast<unsigned char>(*in) < 0x80; in++) {
+            *dst++ = static_cast<CharT>(*in);
+        }
+        return in;
+    }
+
+    // 与 _widen_ascii 相反, 从 in 开始把连续的 ASCII 字符写为单字节
+    template <typename CharT>
+    static const CharT *_narrow_ascii(const CharT *in, const CharT *end, char *&dst) noexcept {
+#ifdef CQ_SIMD_X86
+        if constexpr (IS_UTF16<CharT>) {
+            const auto non_ascii = _mm_set1_epi16(static_cast<short>(0xFF80));
+            for (; end - in >= 8; in += 8) {
+                const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(x, non_ascii), _mm_setzero_si128())) != 0xFFFF)
+                    break;
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi16(x, x));
+                dst += 8;
+            }
+        } else {
+            const auto non_ascii = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+            for (; end - in >= 4; in += 4) {
+                const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(x, non_ascii), _mm_setzero_si128())) != 0xFFFF)
+                    break;
+                const auto packed = _mm_packus_epi16(_mm_packs_epi32(x, x), _mm_setzero_si128());
+                const auto bytes = static_cast<uint32_t>(_mm_cvtsi128_si32(packed));
+                std::memcpy(dst, &bytes, 4);
+                dst += 4;
+            }
+        }
+#endif
+        for (; in != end && static_cast<uint32_t>(*in) < 0x80; in++) {
+            *dst++ = static_cast<char>(*in);
+        }
+        return in;
+    }
+
+    template <typename CharT>
+    void utf8_to_wide_to(std::basic_string<CharT> &out, const std::string_view utf8) {
+        // 每个 UTF-8 字节最多产生一个码元 (4 字节的字符产生 2 个 UTF-16 码元)
+        const auto old_size = out.size();
+        out.resize(old_size + utf8.size());
+        const auto out_begin = &out[old_size];
+        auto dst = out_begin;
+
+        auto in = utf8.data();
+        const auto end = in + utf8.size();
+        while (in != end) {
+            in = _widen_ascii(in, end, dst);
+            if (in == end) break;
+
+            size_t len;
+            auto cp = _decode_utf8(reinterpret_cast<const uint8_t *>(in), static_cast<size_t>(end - in), len);
+            in += len;
+            if (IS_UTF16<CharT> && cp >= 0x10000) {
+                cp -= 0x10000;
+                *dst++ = static_cast<CharT>(0xD800 | cp >> 10);
+                *dst++ = static_cast<CharT>(0xDC00 | (cp & 0x3FF));
+            } else {
+                *dst++ = static_cast<CharT>(cp);
+            }
+        }
+        out.resize(old_size + static_cast<size_t>(dst - out_begin));
+    }
+
+    template <typename CharT>
+    void wide_to_utf8_to(std::string &out, const std::basic_string_view<CharT> wide) {
+        // UTF-16 码元最多变为 3 字节 (代理对共 4 字节), UTF-32 码元最多变为 4 字节
+        const auto old_size = out.size();
+        out.resize(old_size + wide.size() * (IS_UTF16<CharT> ? 3 : 4));
+        const auto out_begin = &out[old_size];
+        auto dst = out_begin;
+
+        auto in = wide.data();
+        const auto end = in + wide.size();
+        while (in != end) {
+            in = _narrow_ascii(in, end, dst);
+            if (in == end) break;
+
+            auto cp = static_cast<uint32_t>(*in++);
+            if (cp >= 0xD800 && cp <= 0xDFFF) {
+                const auto low = in != end ? static_cast<uint32_t>(*in) : 0;
+                if (IS_UTF16<CharT> && cp <= 0xDBFF && low >= 0xDC00 && low <= 0xDFFF) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    in++;
+                } else {
+                    cp = REPLACEMENT_CHARACTER;
+                }
+            } else if (cp > 0x10FFFF) {
+                cp = REPLACEMENT_CHARACTER;
+            }
+            dst = _put_utf8(dst, cp);
+        }
+        out.resize(old_size + static_cast<size_t>(dst - out_begin));
+    }
+
+    template void utf8_to_wide_to(std::basic_string<char16_t> &, std::string_view);
+    template void utf8_to_wide_to(std::basic_string<char32_t> &, std::string_view);
+    template void utf8_to_wide_to(std::basic_string<wchar_t> &, std::string_view);
+    template void wide_to_utf8_to(std::string &, std::basic_string_view<char16_t>);
+    template void wide_to_utf8_to(std::string &, std::basic_string_view<char32_t>);
+    template void wide_to_utf8_to(std::string &, std::basic_string_view<wchar_t>);
+} // namespace cq::utils
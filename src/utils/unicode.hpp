@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cq::utils {
+    constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    // 解出 in 开头的一个非 ASCII 的 UTF-8 字符, 返回码位并设置 len 为其字节数;
+    // 非法时 (包括过长编码, 代理码位和超出 U+10FFFF) 返回 REPLACEMENT_CHARACTER, len 为 1
+    inline uint32_t _decode_utf8(const uint8_t *in, const size_t n, size_t &len) noexcept {
+        len = 1;
+        const auto b0 = in[0];
+        size_t size;
+        uint32_t cp, min;
+        if (b0 >= 0xC2 && b0 <= 0xDF) {
+            size = 2, cp = b0 & 0x1F, min = 0x80;
+        } else if (b0 >= 0xE0 && b0 <= 0xEF) {
+            size = 3, cp = b0 & 0x0F, min = 0x800;
+        } else if (b0 >= 0xF0 && b0 <= 0xF4) {
+            size = 4, cp = b0 & 0x07, min = 0x10000;
+        } else {
+            return REPLACEMENT_CHARACTER;
+        }
+        if (n < size) return REPLACEMENT_CHARACTER;
+        for (size_t i = 1; i < size; i++) {
+            if ((in[i] & 0xC0) != 0x80) return REPLACEMENT_CHARACTER;
+            cp = cp << 6 | (in[i] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return REPLACEMENT_CHARACTER;
+        len = size;
+        return cp;
+    }
+
+    // 将码位按 UTF-8 写入 dst, 返回写入之后的位置
+    inline char *_put_utf8(char *dst, const uint32_t cp) noexcept {
+        if (cp < 0x80) {
+            *dst++ = static_cast<char>(cp);
+        } else if (cp < 0x800) {
+            *dst++ = static_cast<char>(0xC0 | cp >> 6);
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *dst++ = static_cast<char>(0xE0 | cp >> 12);
+            *dst++ = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        } else {
+            *dst++ = static_cast<char>(0xF0 | cp >> 18);
+            *dst++ = static_cast<char>(0x80 | (cp >> 12 & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+            *dst++ = static_cast<char>(0x80 | (cp & 0x3F));
+        }
+        return dst;
+    }
+
+    // UTF-8 与 UTF-16 (CharT 为 2 字节时) 或 UTF-32 (CharT 为 4 字节时) 之间的转换, 结果追加到 out;
+    // 非法的 UTF-8 字节, 不成对的代理项和超出范围的码位替换为 U+FFFD, 不抛出异常.
+    // CharT 可以是 char16_t, char32_t 或 wchar_t; 输出按最坏情况一次分配, x86 下 ASCII 部分使用 SSE2 整段转换
+    template <typename CharT>
+    void utf8_to_wide_to(std::basic_string<CharT> &out, std::string_view utf8);
+
+    template <typename CharT>
+    void wide_to_utf8_to(std::string &out, std::basic_string_view<CharT> wide);
+
+    inline std::wstring utf8_to_wide(const std::string_view utf8) {
+        std::wstring out;
+        utf8_to_wide_to(out, utf8);
+        return out;
+    }
+
+    inline std::string wide_to_utf8(const std::wstring_view wide) {
+        std::string out;
+        wide_to_utf8_to(out, wide);
+        return out;
+    }
+} // namespace cq::utils
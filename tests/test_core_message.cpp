@@ -0,0 +1,382 @@
+#include "cqcppsdk/cqcppsdk.h"
+
+#include "catch.hpp"
+
+using namespace cq::message;
+
+TEST_CASE("MessageView", "[message]") {
+    SECTION("text and cq codes") {
+        const std::string msg = "hello [CQ:at,qq=123]&#91;world&#93;[CQ:image, file = a.jpg ,,magic]";
+        std::vector<MessageSegmentView> segs(MessageView(msg).begin(), MessageView(msg).end());
+        REQUIRE(segs.size() == 4);
+
+        REQUIRE_FALSE(segs[0].is_code);
+        REQUIRE(segs[0].type == "text");
+        REQUIRE(segs[0].text == "hello ");
+
+        REQUIRE(segs[1].is_code);
+        REQUIRE(segs[1].type == "at");
+        REQUIRE(segs[1].params.get("qq") == "123");
+        REQUIRE(segs[1].raw == "[CQ:at,qq=123]");
+
+        REQUIRE(segs[2].text == "&#91;world&#93;");
+
+        REQUIRE(segs[3].type == "image");
+        REQUIRE(segs[3].params.get("file ") == " a.jpg");
+        REQUIRE(segs[3].params.get("magic") == "");
+        REQUIRE_FALSE(segs[3].params.get("foo").has_value());
+        REQUIRE(std::distance(segs[3].params.begin(), segs[3].params.end()) == 2);
+
+        // 视图指向原始字符串
+        REQUIRE(segs[0].text.data() == msg.data());
+    }
+
+    SECTION("incomplete cq codes are merged into text") {
+        const std::string msg = "a[CQ:face,id=1[CQ:face,id=2]b[CQ:c";
+        std::vector<MessageSegmentView> segs(MessageView(msg).begin(), MessageView(msg).end());
+        REQUIRE(segs.size() == 3);
+        REQUIRE(segs[0].text == "a[CQ:face,id=1");
+        REQUIRE(segs[1].params.get("id") == "2");
+        REQUIRE(segs[2].text == "b[CQ:c");
+    }
+
+    SECTION("empty") {
+        REQUIRE(MessageView("").begin() == MessageView("").end());
+    }
+}
+
+TEST_CASE("escape and unescape", "[message]") {
+    REQUIRE(escape("a&b[c]d,e") == "a&amp;b&#91;c&#93;d&#44;e");
+    REQUIRE(escape("a&b[c]d,e", false) == "a&amp;b&#91;c&#93;d,e");
+    REQUIRE(escaped_size("a&b[c]d,e") == escape("a&b[c]d,e").size());
+    REQUIRE(escape("") == "");
+
+    const std::string long_text(100, ',');
+    REQUIRE(escape(long_text, false) == long_text);
+    REQUIRE(escape(long_text).size() == 500);
+
+    // 无需转义时直接移动原字符串
+    std::string plain(64, 'x');
+    const auto data = plain.data();
+    REQUIRE(escape(std::move(plain)).data() == data);
+
+    std::string out = "prefix:";
+    escape_to(out, "[x]");
+    REQUIRE(out == "prefix:&#91;x&#93;");
+
+    REQUIRE(unescape("&#91;&amp;#91;&#93;&#44;&amp;") == "[&#91;],&");
+    REQUIRE(unescape("& &am &#9 &#91") == "& &am &#9 &#91");
+    REQUIRE(unescape(std::string("a&amp;b&#44;c&")) == "a&b,c&");
+    REQUIRE(unescape(escape("&#91;[&amp;]")) == "&#91;[&amp;]");
+
+    out = "prefix:";
+    unescape_to(out, "&#91;x&#93;");
+    REQUIRE(out == "prefix:[x]");
+}
+
+TEST_CASE("scan", "[message]") {
+    const std::string msg = "hi [CQ:at,qq=1][CQ:image,file=a.jpg] &#91;x&#93;[CQ:at,qq=2]";
+
+    std::string texts;
+    std::vector<std::string_view> at_users;
+    REQUIRE(scan(
+        msg,
+        [&](const std::string_view text) { texts += text; },
+        [&](const std::string_view type, const ParamsView &params) {
+            if (type == "at") at_users.push_back(*params.get("qq"));
+        }));
+    REQUIRE(texts == "hi  &#91;x&#93;");
+    REQUIRE(at_users == std::vector<std::string_view>{"1", "2"});
+
+    // 找到图片后即停止
+    size_t codes_seen = 0;
+    const auto completed = scan(
+        msg,
+        [](const std::string_view) { return true; },
+        [&](const std::string_view type, const ParamsView &) {
+            codes_seen++;
+            return type != "image";
+        });
+    REQUIRE_FALSE(completed);
+    REQUIRE(codes_seen == 2);
+}
+
+TEST_CASE("split", "[message]") {
+    const auto chunks = [](const std::string_view msg, const size_t max_bytes) {
+        const auto splitter = split(msg, max_bytes);
+        return std::vector<std::string_view>(splitter.begin(), splitter.end());
+    };
+    using Chunks = std::vector<std::string_view>;
+
+    REQUIRE(chunks("", 10).empty());
+    REQUIRE(chunks("aaaaaaaaaa", 4) == Chunks{"aaaa", "aaaa", "aa"});
+    REQUIRE(chunks("aa[CQ:face,id=1]bb", 5) == Chunks{"aa", "[CQ:face,id=1]", "bb"});
+    REQUIRE(chunks("a&#91;b", 3) == Chunks{"a", "&#91;", "b"});
+    REQUIRE(chunks("\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xb8\x96\xe7\x95\x8c", 5)
+            == Chunks{"\xe4\xbd\xa0\xe5\xa5\xbd", "\xe4\xb8\x96\xe7\x95\x8c"});
+    REQUIRE(chunks("line1\nline2 more text", 12) == Chunks{"line1\n", "line2 more t", "ext"});
+    REQUIRE(chunks("a\nbcdefghijk", 10) == Chunks{"a\nbcdefghi", "jk"}); // 换行太靠前时不在换行处切分
+
+    // 假名 (2 字节) 和 BMP 之外的字符 (4 字节) 按实际的 GB18030 长度计算, 块正好填满预算
+    const std::string kana = u8"あいうえおかきくけこ";
+    REQUIRE(chunks(kana, 10) == Chunks{u8"あいうえお", u8"かきくけこ"});
+    const std::string emoji = u8"😀あ😀あ😀あ";
+    for (const auto chunk : chunks(emoji, 6)) {
+        REQUIRE(chunk == u8"😀あ");
+        REQUIRE(cq::utils::utf8_to_gb18030(chunk).size() == 6);
+    }
+    REQUIRE(chunks(u8"한국어", 8) == Chunks{u8"한국", u8"어"}); // 韩文音节为 4 字节
+    REQUIRE(chunks("a\xFF" "b", 2) == Chunks{"a\xFF", "b"}); // 非法字节转换为 '?', 按 1 字节计
+
+    std::string msg;
+    for (auto i = 0; i < 100; i++) msg += "line &amp; [CQ:at,qq=" + std::to_string(i) + "]\xe4\xbd\xa0\n";
+    std::string joined;
+    for (const auto chunk : split(msg, 100)) {
+        REQUIRE(cq::utils::gb18030_size(chunk) <= 100);
+        REQUIRE(cq::utils::gb18030_size(chunk) == cq::utils::utf8_to_gb18030(chunk).size());
+        REQUIRE(Message(std::string(chunk)).size() > 0);
+        joined += chunk;
+    }
+    REQUIRE(joined == msg);
+}
+
+TEST_CASE("Message::Message(string)", "[message]") {
+    const Message msg = "&#91;hi&#93; [CQ:at,qq=123] [CQ:share,title=a&#44;b,url=http://x]";
+    REQUIRE(msg.size() == 4);
+    auto it = msg.begin();
+    REQUIRE(*it++ == MessageSegment::text("[hi] "));
+    REQUIRE(*it++ == MessageSegment::at(123));
+    REQUIRE(*it++ == MessageSegment::text(" "));
+    REQUIRE(it->type == "share");
+    REQUIRE(it->data.at("title") == "a,b");
+    REQUIRE(std::string(msg) == "&#91;hi&#93; [CQ:at,qq=123] [CQ:share,title=a&#44;b,url=http://x]");
+
+    REQUIRE(Message("").empty());
+    REQUIRE(Message("[CQ:a").size() == 1);
+}
+
+TEST_CASE("Message::serialized_size", "[message]") {
+    Message msg;
+    msg.push_back(MessageSegment::text("a[b],c&"));
+    msg.push_back(MessageSegment::share("http://x?a=1&b=2", "t,[1]"));
+    msg.push_back(MessageSegment{"", {{"k", "v"}}});
+    msg.push_back(MessageSegment{"text", {}});
+    msg.push_back(MessageSegment::at(123));
+
+    const auto str = std::string(msg);
+    REQUIRE(str == "a&#91;b&#93;,c&amp;[CQ:share,content=,image=,title=t&#44;&#91;1&#93;,url=http://x?a=1&amp;b=2]"
+                   "[CQ:at,qq=123]");
+    REQUIRE(msg.serialized_size() == str.size());
+    for (const auto &seg : msg) REQUIRE(seg.serialized_size() == std::string(seg).size());
+
+    std::string out = "prefix:";
+    msg.append_to(out);
+    REQUIRE(out == "prefix:" + str);
+}
+
+TEST_CASE("Message::reduce", "[message]") {
+    Message msg{MessageSegment::text("a"),
+                MessageSegment::text("b"),
+                MessageSegment::face(1),
+                MessageSegment::text("c"),
+                MessageSegment::text("d"),
+                MessageSegment::text("e")};
+    msg.reduce();
+    REQUIRE(msg == Message{MessageSegment::text("ab"), MessageSegment::face(1), MessageSegment::text("cde")});
+    REQUIRE(msg.size() == 3);
+
+    Message empty_text{MessageSegment::text("")};
+    empty_text.reduce();
+    REQUIRE(empty_text.empty());
+}
+
+TEST_CASE("Message::operator+=", "[message]") {
+    Message msg;
+    std::string expected;
+    for (auto i = 0; i < 10; i++) {
+        msg += MessageSegment::text("a");
+        msg += "b";
+        msg += Message{MessageSegment::text("c"), MessageSegment::text("d")};
+        expected += "abcd";
+    }
+    REQUIRE(msg.size() == 1);
+    REQUIRE(msg.front().data.at("text") == expected);
+
+    msg += MessageSegment::face(1);
+    const Message tail{MessageSegment::text("x"), MessageSegment::at(1), MessageSegment::text("y")};
+    msg += tail;
+    msg += std::string("z");
+    REQUIRE(msg.size() == 5);
+    REQUIRE(msg.back().data.at("text") == "yz");
+
+    Message empty;
+    empty += Message{MessageSegment::text("")};
+    REQUIRE(empty.empty());
+}
+
+TEST_CASE("Message::operator+", "[message]") {
+    const Message a = "a";
+    const auto b = MessageSegment::face(1);
+    REQUIRE(std::string(a + "b" + b + "c") == "ab[CQ:face,id=1]c");
+    REQUIRE(std::string("x" + a) == "xa");
+    REQUIRE(std::string(Message("p") + Message("q")) == "pq");
+    REQUIRE(std::string(a) == "a");
+}
+
+TEST_CASE("Message::types", "[message]") {
+    Message msg = "hi [CQ:image,file=a.jpg]";
+    REQUIRE(msg.has<SegmentType::IMAGE>());
+    REQUIRE(msg.has(SegmentType::TEXT));
+    REQUIRE_FALSE(msg.has(SegmentType::RECORD));
+    REQUIRE(msg.types().has_any({SegmentType::RECORD, SegmentType::IMAGE}));
+    REQUIRE_FALSE(msg.types().has_all({SegmentType::RECORD, SegmentType::IMAGE}));
+    REQUIRE(msg.types() == MessageView("hi [CQ:image,file=a.jpg]").types());
+
+    msg += MessageSegment::record("b.amr");
+    REQUIRE(msg.has(SegmentType::RECORD));
+    msg += Message("[CQ:at,qq=1]");
+    REQUIRE(msg.has(SegmentType::AT));
+
+    // 通过非 const 接口修改后重新计算
+    msg[1] = MessageSegment::face(1);
+    REQUIRE_FALSE(msg.has(SegmentType::IMAGE));
+    REQUIRE(msg.has(SegmentType::FACE));
+    msg.erase(msg.begin() + 1);
+    REQUIRE_FALSE(msg.has(SegmentType::FACE));
+    for (auto &seg : msg) seg = MessageSegment::text("x");
+    REQUIRE(msg.types() == SegmentTypeMask(SegmentType::TEXT));
+    msg.segments().clear();
+    REQUIRE(msg.types().empty());
+
+    msg += msg;
+    REQUIRE(msg.types().empty());
+    Message empty;
+    empty += MessageSegment::text("");
+    REQUIRE(empty.types().empty());
+}
+
+TEST_CASE("Message equality and hash", "[message]") {
+    const Message split{MessageSegment::text("ab"),
+                        MessageSegment{"", {}},
+                        MessageSegment::text(""),
+                        MessageSegment::text("c"),
+                        MessageSegment::at(1)};
+    const Message merged{MessageSegment::text("abc"), MessageSegment::at(1)};
+    REQUIRE(split == merged);
+    REQUIRE(hash(split) == hash(merged));
+    REQUIRE(std::hash<Message>()(split) == std::hash<Message>()(merged));
+    REQUIRE(split == Message("abc[CQ:at,qq=1]"));
+
+    REQUIRE(merged != Message{MessageSegment::text("abd"), MessageSegment::at(1)});
+    REQUIRE(merged != Message{MessageSegment::text("ab"), MessageSegment::at(1)});
+    REQUIRE(merged != Message{MessageSegment::text("abc"), MessageSegment::at(2)});
+    REQUIRE(merged != Message{MessageSegment::text("abc"), MessageSegment::at(1), MessageSegment::text("d")});
+    REQUIRE(hash(merged) != hash(Message{MessageSegment::text("abc"), MessageSegment::at(2)}));
+    REQUIRE(hash(Message("a[CQ:face,id=1]b")) != hash(Message("ab[CQ:face,id=1]")));
+
+    REQUIRE(MessageSegment::text("") == MessageSegment{"", {}});
+    REQUIRE(MessageSegment::face(1) != MessageSegment::emoji(1));
+    REQUIRE(hash(MessageSegment::face(1)) == hash(MessageSegment{"face", {{"id", "1"}}}));
+    REQUIRE(Message() == Message(""));
+    REQUIRE(hash(Message()) == hash(Message{MessageSegment::text("")}));
+
+    const std::unordered_set<Message> seen{merged};
+    REQUIRE(seen.count(split) == 1);
+}
+
+TEST_CASE("to_typed", "[message]") {
+    const Message msg = "hi[CQ:at,qq=123][CQ:face,id=14][CQ:image,file=a.jpg][CQ:record,file=b.amr,magic=true][CQ:dice]"
+                        "[CQ:share,content=c,image=i,title=t,url=u][CQ:at,qq=all][CQ:face,id=014][CQ:image,file=a,x=1]"
+                        "[CQ:custom,k=v]";
+    const auto typed = to_typed(msg);
+    REQUIRE(typed.size() == msg.size());
+    REQUIRE(std::get<TextSegment>(typed[0]).text == "hi");
+    REQUIRE(std::get<AtSegment>(typed[1]).user_id == 123);
+    REQUIRE(std::get<FaceSegment>(typed[2]).id == 14);
+    REQUIRE(std::get<ImageSegment>(typed[3]).file == "a.jpg");
+    REQUIRE(std::get<RecordSegment>(typed[4]).magic);
+    REQUIRE(std::holds_alternative<DiceSegment>(typed[5]));
+    REQUIRE(std::get<ShareSegment>(typed[6]).image_url == "i");
+
+    // 无法无损表示的消息段保留为通用形式
+    REQUIRE(std::get<MessageSegment>(typed[7]).data.at("qq") == "all");
+    REQUIRE(std::holds_alternative<MessageSegment>(typed[8]));
+    REQUIRE(std::holds_alternative<MessageSegment>(typed[9]));
+    REQUIRE(std::holds_alternative<MessageSegment>(typed[10]));
+
+    REQUIRE(to_message(typed) == msg);
+    for (size_t i = 0; i < msg.size(); i++) REQUIRE(to_segment(typed[i]) == msg[i]);
+
+    auto seg = MessageSegment::image("moved.jpg");
+    REQUIRE(std::get<ImageSegment>(to_typed(std::move(seg))).file == "moved.jpg");
+}
+
+TEST_CASE("SegmentType", "[message]") {
+    const SegmentType text = "text";
+    REQUIRE(text.kind() == SegmentType::TEXT);
+    REQUIRE(text == SegmentType::TEXT);
+    REQUIRE(text == "text");
+    REQUIRE(std::string("text") == text);
+    REQUIRE(text.name() == "text");
+
+    const SegmentType custom = std::string("my_code");
+    REQUIRE(custom.kind() == SegmentType::CUSTOM);
+    REQUIRE(custom == "my_code");
+    REQUIRE(custom != SegmentType("other_code"));
+    REQUIRE(custom == SegmentType(custom));
+    REQUIRE("[CQ:" + custom == "[CQ:my_code");
+
+    REQUIRE(SegmentType().empty());
+    REQUIRE(SegmentType("").empty());
+    REQUIRE(sizeof(SegmentType) < sizeof(std::string));
+
+    const Message msg = "[CQ:image,file=a.jpg][CQ:my_code,x=1]";
+    REQUIRE(msg.front().type == SegmentType::IMAGE);
+    REQUIRE(msg.back().type == "my_code");
+    REQUIRE(std::string(msg) == "[CQ:image,file=a.jpg][CQ:my_code,x=1]");
+}
+
+TEST_CASE("MessageEvent::parsed_message", "[message]") {
+    auto event =
+        cq::PrivateMessageEvent(1, 1, "hello [CQ:face,id=1] world", 0, cq::PrivateMessageEvent::SubType::FRIEND);
+    const auto &parsed = event.parsed_message();
+    REQUIRE(parsed.size() == 3);
+    REQUIRE(&event.parsed_message() == &parsed); // 只解析一次
+    REQUIRE(event.plain_text() == "hello   world");
+    REQUIRE(std::distance(event.message_view().begin(), event.message_view().end()) == 3);
+
+    const auto copy = event;
+    REQUIRE(&copy.parsed_message() == &parsed); // 复制的事件共享解析结果
+
+    event.set_message("[CQ:at,qq=1]");
+    REQUIRE(event.parsed_message() == Message{MessageSegment::at(1)});
+    REQUIRE(event.plain_text().empty());
+    REQUIRE(copy.parsed_message().size() == 3);
+
+    // 直接赋值 message 后同样重新解析
+    event.message = "again [CQ:face,id=2]";
+    REQUIRE(event.parsed_message().size() == 2);
+    REQUIRE(event.plain_text() == "again ");
+
+    // 复制的事件修改 message 后不会读到原事件的缓存, 也不影响原事件
+    auto changed_copy = event;
+    REQUIRE(&changed_copy.parsed_message() == &event.parsed_message());
+    changed_copy.message = "copy";
+    REQUIRE(changed_copy.plain_text() == "copy");
+    REQUIRE(event.plain_text() == "again ");
+}
+
+TEST_CASE("format", "[message]") {
+    REQUIRE(format(CQ_MESSAGE_FORMAT("[CQ:at,qq={}] {}"), 123, "a[b],c") == "[CQ:at,qq=123] a&#91;b&#93;,c");
+    REQUIRE(format(CQ_MESSAGE_FORMAT("[CQ:share,title={},url={}]"), std::string("a,b"), std::string_view("u"))
+            == "[CQ:share,title=a&#44;b,url=u]");
+    REQUIRE(format(CQ_MESSAGE_FORMAT("{{{}}} {} {}"), -1, true, 0.5) == "{-1} true 0.500000");
+    REQUIRE(format(CQ_MESSAGE_FORMAT("no slots [CQ:face,id=1]")) == "no slots [CQ:face,id=1]");
+
+    const auto at = MessageSegment::at(1);
+    const Message msg = "x[CQ:face,id=2]";
+    REQUIRE(format(CQ_MESSAGE_FORMAT("{}: {} {}"), at, msg, raw("&#91;")) == "[CQ:at,qq=1]: x[CQ:face,id=2] &#91;");
+
+    constexpr auto fmt = CQ_MESSAGE_FORMAT("[CQ:image,file={}]");
+    REQUIRE(format(fmt, "a.jpg") == std::string(MessageSegment::image("a.jpg")));
+}
@@ -0,0 +1,230 @@
+#include "../src/core/type.hpp"
+
+#include <string>
+#include <vector>
+
+#include "catch.hpp"
+
+using namespace cq;
+
+namespace {
+    // 按酷Q的格式拼接大端序二进制数据
+    struct Packer {
+        std::string bytes;
+
+        template <typename IntType>
+        Packer &int_(const IntType value) {
+            for (auto i = static_cast<int>(sizeof(IntType)) - 1; i >= 0; i--) {
+                bytes += static_cast<char>((static_cast<uint64_t>(value) >> (i * 8)) & 0xFF);
+            }
+            return *this;
+        }
+
+        Packer &token(const std::string &str) {
+            int_(static_cast<int16_t>(str.size()));
+            bytes += str;
+            return *this;
+        }
+
+        std::string base64() const {
+            return utils::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                        static_cast<unsigned int>(bytes.size()));
+        }
+    };
+
+    std::string group_member_bytes(const int64_t user_id, const std::string &card) {
+        return Packer()
+            .int_<int64_t>(12345)
+            .int_<int64_t>(user_id)
+            .token("nick")
+            .token(card)
+            .int_<int32_t>(1)
+            .int_<int32_t>(20)
+            .token("area")
+            .int_<int32_t>(1500000000)
+            .int_<int32_t>(1600000000)
+            .token("lv")
+            .int_<int32_t>(3)
+            .int_<int32_t>(0)
+            .token("title")
+            .int_<int32_t>(-1)
+            .int_<int32_t>(1)
+            .bytes;
+    }
+} // namespace
+
+TEST_CASE("ObjectHelper::from_base64", "[type]") {
+    const auto member = ObjectHelper::from_base64<GroupMember>(Packer{group_member_bytes(10001, "card")}.base64());
+    REQUIRE(member.group_id == 12345);
+    REQUIRE(member.user_id == 10001);
+    REQUIRE(member.nickname == "nick");
+    REQUIRE(member.card == "card");
+    REQUIRE(member.sex == Sex::FEMALE);
+    REQUIRE(member.age == 20);
+    REQUIRE(member.area == "area");
+    REQUIRE(member.join_time == 1500000000);
+    REQUIRE(member.last_sent_time == 1600000000);
+    REQUIRE(member.level == "lv");
+    REQUIRE(member.role == GroupRole::OWNER);
+    REQUIRE_FALSE(member.unfriendly);
+    REQUIRE(member.title == "title");
+    REQUIRE(member.title_expire_time == -1);
+    REQUIRE(member.card_changeable);
+
+    const auto group = ObjectHelper::from_base64<Group>(Packer().int_<int64_t>(12345).token("group").base64());
+    REQUIRE(group.group_id == 12345);
+    REQUIRE(group.group_name == "group");
+    REQUIRE(group.member_count == 0);
+
+    REQUIRE_THROWS_AS(ObjectHelper::from_base64<User>(Packer().int_<int64_t>(1).token("n").base64()), ParseError);
+}
+
+TEST_CASE("ObjectHelper::try_from_base64", "[type]") {
+    const auto user = ObjectHelper::try_from_base64<User>(
+        Packer().int_<int64_t>(10001).token("nick").int_<int32_t>(0).int_<int32_t>(18).base64());
+    REQUIRE(user);
+    REQUIRE(user->nickname == "nick");
+    REQUIRE(user->sex == Sex::MALE);
+    REQUIRE(user->age == 18);
+    REQUIRE_FALSE(ObjectHelper::try_from_base64<User>(Packer().int_<int64_t>(1).token("n").base64()));
+
+    // 非匿名消息的匿名信息为空字符串
+    REQUIRE_FALSE(ObjectHelper::try_from_base64<Anonymous>(""));
+    const auto anonymous_b64 = Packer().int_<int64_t>(7).token("anon").token("tok").base64();
+    const auto anonymous = ObjectHelper::try_from_base64<Anonymous>(anonymous_b64);
+    REQUIRE(anonymous);
+    REQUIRE(anonymous->id == 7);
+    REQUIRE(anonymous->token == "tok");
+    REQUIRE(anonymous->base64 == anonymous_b64);
+    REQUIRE_THROWS_AS(ObjectHelper::from_base64<Anonymous>(""), ParseError);
+
+    // get_group_list() 返回的群信息没有成员数
+    const auto group = ObjectHelper::try_from_base64<Group>(
+        Packer().int_<int64_t>(1).token("g").int_<int32_t>(10).int_<int32_t>(200).base64());
+    REQUIRE(group);
+    REQUIRE(group->member_count == 10);
+    REQUIRE(group->max_member_count == 200);
+}
+
+TEST_CASE("ObjectHelper::multi_from_base64", "[type]") {
+    Packer list;
+    list.int_<int32_t>(3);
+    for (auto i = 0; i < 3; i++) list.token(group_member_bytes(10000 + i, std::string(i, 'c')));
+
+    const auto members = ObjectHelper::multi_from_base64<std::vector<GroupMember>>(list.base64());
+    REQUIRE(members.size() == 3);
+    for (auto i = 0; i < 3; i++) {
+        REQUIRE(members[i].user_id == 10000 + i);
+        REQUIRE(members[i].card == std::string(i, 'c'));
+    }
+
+    // 记录被截断
+    list.bytes.pop_back();
+    REQUIRE_THROWS_AS(ObjectHelper::multi_from_base64<std::vector<GroupMember>>(list.base64()), ParseError);
+}
+
+TEST_CASE("ObjectHelper::multi_from_base64 decodes large lists in parallel", "[type]") {
+    // 超过并行解析的阈值, 结果应保持原顺序
+    constexpr auto count = 5000;
+    Packer list;
+    list.int_<int32_t>(count);
+    for (auto i = 0; i < count; i++) list.token(group_member_bytes(10000 + i, std::string(i % 7, 'c')));
+
+    const auto members = ObjectHelper::multi_from_base64<std::vector<GroupMember>>(list.base64());
+    REQUIRE(members.size() == count);
+    for (auto i = 0; i < count; i++) {
+        REQUIRE(members[i].user_id == 10000 + i);
+        REQUIRE(members[i].card == std::string(i % 7, 'c'));
+    }
+
+    // 任一段中的记录无法解析时抛出异常
+    Packer broken;
+    broken.int_<int32_t>(count);
+    for (auto i = 0; i < count; i++) broken.token(i == count - 1 ? "short" : group_member_bytes(i, ""));
+    REQUIRE_THROWS_AS(ObjectHelper::multi_from_base64<std::vector<GroupMember>>(broken.base64()), ParseError);
+
+    list.bytes.pop_back();
+    REQUIRE_THROWS_AS(ObjectHelper::multi_from_base64<std::vector<GroupMember>>(list.base64()), ParseError);
+}
+
+TEST_CASE("GroupMemberTable", "[type]") {
+    Packer list;
+    list.int_<int32_t>(3);
+    for (auto i = 0; i < 3; i++) list.token(group_member_bytes(10000 + i, std::string(i, 'c')));
+
+    const auto table = ObjectHelper::from_base64<GroupMemberTable>(list.base64());
+    REQUIRE(table.size() == 3);
+    for (size_t i = 0; i < 3; i++) {
+        REQUIRE(table.user_id(i) == 10000 + static_cast<int64_t>(i));
+        REQUIRE(table.role(i) == GroupRole::OWNER);
+        REQUIRE(table.card(i) == std::string(i, 'c'));
+        REQUIRE(table.title(i) == "title");
+    }
+
+    const auto member = table[2];
+    const auto expected = ObjectHelper::from_base64<GroupMember>(Packer{group_member_bytes(10002, "cc")}.base64());
+    REQUIRE(member.group_id == expected.group_id);
+    REQUIRE(member.nickname == expected.nickname);
+    REQUIRE(member.sex == expected.sex);
+    REQUIRE(member.area == expected.area);
+    REQUIRE(member.last_sent_time == expected.last_sent_time);
+    REQUIRE(member.level == expected.level);
+    REQUIRE(member.title_expire_time == expected.title_expire_time);
+    REQUIRE(member.card_changeable == expected.card_changeable);
+
+    REQUIRE(ObjectHelper::from_base64<GroupMemberTable>(Packer().int_<int32_t>(0).base64()).empty());
+
+    list.bytes.pop_back();
+    REQUIRE_THROWS_AS(ObjectHelper::from_base64<GroupMemberTable>(list.base64()), ParseError);
+
+    // 记录数不可信时不应按其预留空间
+    Packer hostile;
+    hostile.int_<int32_t>(INT32_MAX).token(group_member_bytes(10000, ""));
+    REQUIRE_THROWS_AS(ObjectHelper::from_base64<GroupMemberTable>(hostile.base64()), ParseError);
+}
+
+TEST_CASE("ObjectHelper::to_base64 round trips", "[type]") {
+    GroupMember member;
+    member.group_id = 12345;
+    member.user_id = 10001;
+    member.nickname = "nick";
+    member.card = "card";
+    member.sex = Sex::FEMALE;
+    member.role = GroupRole::ADMIN;
+    member.unfriendly = true;
+    member.title_expire_time = -1;
+
+    // 编码结果与手工拼接的格式一致
+    auto expected = Packer()
+                        .int_<int64_t>(12345)
+                        .int_<int64_t>(10001)
+                        .token("nick")
+                        .token("card")
+                        .int_<int32_t>(1)
+                        .int_<int32_t>(0)
+                        .token("")
+                        .int_<int32_t>(0)
+                        .int_<int32_t>(0)
+                        .token("")
+                        .int_<int32_t>(2)
+                        .int_<int32_t>(1)
+                        .token("")
+                        .int_<int32_t>(-1)
+                        .int_<int32_t>(0);
+    REQUIRE(ObjectHelper::to_base64(member) == expected.base64());
+
+    const auto members = ObjectHelper::multi_from_base64<std::vector<GroupMember>>(
+        ObjectHelper::multi_to_base64(std::vector<GroupMember>{member, member}));
+    REQUIRE(members.size() == 2);
+    REQUIRE(members[1].card == "card");
+    REQUIRE(members[1].role == GroupRole::ADMIN);
+    REQUIRE(members[1].unfriendly);
+
+    Group group;
+    group.group_id = 1;
+    group.group_name = "g";
+    group.member_count = 10;
+    const auto decoded = ObjectHelper::from_base64<Group>(ObjectHelper::to_base64(group));
+    REQUIRE(decoded.group_name == "g");
+    REQUIRE(decoded.member_count == 10);
+}
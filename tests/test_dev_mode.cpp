@@ -0,0 +1,31 @@
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include <iostream>
+#include <sstream>
+
+#include "../src/core/api.hpp"
+
+using namespace cq;
+
+// 捕获调用 f 期间输出到 std::cout 的内容
+template <typename F>
+static std::string capture_cout(F &&f) {
+    std::ostringstream out;
+    const auto old_buf = std::cout.rdbuf(out.rdbuf());
+    f();
+    std::cout.rdbuf(old_buf);
+    return out.str();
+}
+
+TEST_CASE("dev mode prints encoded messages as UTF-8", "[dev_mode]") {
+    const std::string message = u8"你好, 世界 🌏";
+    const auto plain = capture_cout([&] { send_group_message(123, message); });
+    REQUIRE(plain.find(message) != std::string::npos);
+
+    const EncodedMessage encoded(message);
+    REQUIRE(encoded.bytes() != message);
+    REQUIRE(capture_cout([&] { send_group_message(123, encoded); }) == plain);
+    REQUIRE(capture_cout([&] { send_private_message(123, encoded); }).find(message) != std::string::npos);
+    REQUIRE(capture_cout([&] { send_discuss_message(123, encoded); }).find(message) != std::string::npos);
+}
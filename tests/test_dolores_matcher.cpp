@@ -162,6 +162,15 @@ TEST_CASE("matchers::at_me", "[matcher]") {
     }
 }
 
+TEST_CASE("matchers::has_segment", "[matcher]") {
+    using cq::message::SegmentType;
+    auto [event, matcher_data] = construct_pm();
+    REQUIRE_FALSE(to_matcher(has_segment({SegmentType::IMAGE, SegmentType::RECORD}))->match(event, matcher_data));
+    event.message = "look [CQ:image,file=a.jpg]";
+    REQUIRE(to_matcher(has_segment({SegmentType::IMAGE, SegmentType::RECORD}))->match(event, matcher_data));
+    REQUIRE_FALSE(to_matcher(has_segment(SegmentType::AT))->match(event, matcher_data));
+}
+
 TEST_CASE("matchers::user", "[matcher]") {
     auto [event, matcher_data] = construct_pm();
     REQUIRE(to_matcher(user())->match(event, matcher_data));
@@ -0,0 +1,96 @@
+#include "../src/utils/base64.hpp"
+
+#include <random>
+#include <string>
+
+#include "catch.hpp"
+
+using cq::utils::base64_decode_to;
+
+namespace utils = cq::utils;
+
+static std::string encode(const std::string &bytes) {
+    return utils::base64_encode(reinterpret_cast<const unsigned char *>(bytes.data()),
+                                static_cast<unsigned>(bytes.size()));
+}
+
+static bool is_base64_char(const char ch) {
+    return (ch >= 'A' && ch <= 'Z') || (ch >= 'a' && ch <= 'z') || (ch >= '0' && ch <= '9') || ch == '+' || ch == '/';
+}
+
+TEST_CASE("base64_encode", "[base64]") {
+    REQUIRE(encode("") == "");
+    REQUIRE(encode("a") == "YQ==");
+    REQUIRE(encode("ab") == "YWI=");
+    REQUIRE(encode("abc") == "YWJj");
+    REQUIRE(encode(std::string("\x00\xfb\xff", 3)) == "APv/");
+}
+
+TEST_CASE("base64_decode", "[base64]") {
+    REQUIRE(utils::base64_decode("") == "");
+    REQUIRE(utils::base64_decode("YQ==") == "a");
+    REQUIRE(utils::base64_decode("YWI=") == "ab");
+    REQUIRE(utils::base64_decode("YWJj") == "abc");
+    REQUIRE(utils::base64_decode("YWJjZA") == "abcd");
+    REQUIRE(utils::base64_decode("APv/") == std::string("\x00\xfb\xff", 3));
+
+    // 与原实现一致, 遇到非 Base64 字符时停止
+    REQUIRE(utils::base64_decode("YWJj\nZGVm") == "abc");
+    REQUIRE(utils::base64_decode("YW*j") == "a");
+}
+
+TEST_CASE("base64_decode_to appends to the buffer and validates", "[base64]") {
+    std::string out = "x";
+    REQUIRE(base64_decode_to(out, "YWJj"));
+    REQUIRE(base64_decode_to(out, "ZA=="));
+    REQUIRE(out == "xabcd");
+
+    std::string tmp;
+    REQUIRE(base64_decode_to(tmp, ""));
+    REQUIRE(base64_decode_to(tmp, "YWI"));
+    REQUIRE(base64_decode_to(tmp, "YWI="));
+    REQUIRE_FALSE(base64_decode_to(tmp, "YWI=="));
+    REQUIRE_FALSE(base64_decode_to(tmp, "YWJj="));
+    REQUIRE_FALSE(base64_decode_to(tmp, "YWJjZ"));
+    REQUIRE_FALSE(base64_decode_to(tmp, "YQ==YQ=="));
+    REQUIRE_FALSE(base64_decode_to(tmp, "YWJj ZA=="));
+}
+
+TEST_CASE("base64 round trip and invalid characters", "[base64]") {
+    // 覆盖 AVX2/SSSE3 分组和逐字符处理的尾部
+    std::mt19937 rng(42);
+    for (auto len = 0; len < 160; len++) {
+        std::string bytes(len, '\0');
+        for (auto &ch : bytes) ch = static_cast<char>(rng());
+        const auto b64 = encode(bytes);
+        std::string out;
+        REQUIRE(base64_decode_to(out, b64));
+        REQUIRE(out == bytes);
+
+        // 解码在第一个非法字符处停止
+        for (size_t pos = 0; pos < b64.size() && b64[pos] != '='; pos++) {
+            auto broken = b64;
+            do {
+                broken[pos] = static_cast<char>(rng());
+            } while (is_base64_char(broken[pos]));
+            REQUIRE(utils::base64_decode(broken) == bytes.substr(0, pos * 3 / 4));
+        }
+    }
+}
+
+TEST_CASE("base64_decode checks every byte value", "[base64]") {
+    const std::string b64(96, 'A');
+    for (auto value = 0; value < 256; value++) {
+        const auto ch = static_cast<char>(value);
+        for (const auto pos : {0, 17, 40, 95}) {
+            auto str = b64;
+            str[pos] = ch;
+            const auto decoded = utils::base64_decode(str);
+            if (is_base64_char(ch)) {
+                REQUIRE(decoded.size() == 72);
+            } else {
+                REQUIRE(decoded == std::string(pos * 3 / 4, '\0'));
+            }
+        }
+    }
+}
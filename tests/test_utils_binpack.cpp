@@ -0,0 +1,82 @@
+#include "../src/utils/binpack.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "catch.hpp"
+
+using cq::BytesNotEnough;
+using cq::utils::BinPack;
+using cq::utils::BinPackView;
+
+static const std::string bytes("\x12\x34"
+                               "\xff\xff\xff\xfe"
+                               "\x01\x02\x03\x04\x05\x06\x07\x08"
+                               "\x00\x03"
+                               "abc"
+                               "\x00\x00\x00\x01",
+                               23);
+
+TEST_CASE("BinPackView reads big-endian integers", "[binpack]") {
+    BinPackView pack(bytes);
+    REQUIRE(pack.size() == bytes.size());
+    REQUIRE(pack.pop_int<int16_t>() == 0x1234);
+    REQUIRE(pack.pop_int<int32_t>() == -2);
+    REQUIRE(pack.pop_int<int64_t>() == 0x0102030405060708);
+    REQUIRE(pack.pop_int<uint8_t>() == 0);
+    REQUIRE(pack.pop_int<uint8_t>() == 3);
+}
+
+TEST_CASE("BinPackView returns views into the original bytes", "[binpack]") {
+    BinPackView pack(bytes);
+    REQUIRE(pack.pop_bytes(2) == std::string_view("\x12\x34"));
+    pack.pop_bytes(12);
+
+    const auto token = pack.pop_token();
+    REQUIRE(token == "abc");
+    REQUIRE(token.data() == bytes.data() + 16);
+    REQUIRE(pack.pop_bool());
+    REQUIRE(pack.empty());
+}
+
+TEST_CASE("BinPackView throws when bytes are not enough", "[binpack]") {
+    BinPackView pack(std::string_view(bytes).substr(0, 3));
+    REQUIRE_THROWS_AS(pack.pop_int<int32_t>(), BytesNotEnough);
+    REQUIRE(pack.pop_int<int16_t>() == 0x1234);
+    REQUIRE_THROWS_AS(pack.pop_bytes(2), BytesNotEnough);
+    REQUIRE(pack.size() == 1);
+}
+
+TEST_CASE("BinPack and BinPackView read the same values", "[binpack]") {
+    BinPack pack(bytes);
+    BinPackView view(bytes);
+    REQUIRE(pack.pop_int<int16_t>() == view.pop_int<int16_t>());
+    REQUIRE(pack.pop_int<int32_t>() == view.pop_int<int32_t>());
+    REQUIRE(pack.pop_int<int64_t>() == view.pop_int<int64_t>());
+    REQUIRE(pack.pop_string() == view.pop_string());
+    REQUIRE(pack.pop_bool() == view.pop_bool());
+}
+
+TEST_CASE("BinPackView try_pop_* reports missing bytes without throwing", "[binpack]") {
+    BinPackView pack(std::string_view(bytes).substr(0, 18));
+    int16_t i16 = 0;
+    REQUIRE(pack.try_pop_int(i16));
+    REQUIRE(i16 == 0x1234);
+
+    // 失败时不修改输出和剩余数据
+    int64_t i64 = 42;
+    std::string_view token;
+    REQUIRE(pack.try_pop_bytes(12, token));
+    REQUIRE_FALSE(pack.try_pop_int(i64));
+    REQUIRE(i64 == 42);
+    REQUIRE_FALSE(pack.try_pop_token(token));
+    REQUIRE(pack.size() == 4);
+
+    BinPackView full(std::string_view(bytes).substr(14, 8));
+    std::string str;
+    REQUIRE(full.try_pop_string(str));
+    REQUIRE(str == "abc");
+    bool flag = false;
+    REQUIRE_FALSE(full.try_pop_bool(flag));
+    REQUIRE(full.size() == 3);
+}
@@ -0,0 +1,109 @@
+#include "../src/utils/binschema.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "catch.hpp"
+
+using namespace cq::utils;
+
+namespace {
+    enum class Kind { A = 1, B = 2 };
+
+    struct Record {
+        int64_t id = 0;
+        std::string name;
+        Kind kind = Kind::A;
+        bool flag = false;
+        std::string raw;
+        int16_t tail = 0;
+
+        using Schema = BinSchema<Record,
+                                 Field<&Record::id, wire::Int64>,
+                                 Field<&Record::name, wire::String>,
+                                 Field<&Record::kind, wire::Int32>,
+                                 Field<&Record::flag, wire::Bool>,
+                                 Field<&Record::raw, wire::Bytes>,
+                                 Field<&Record::tail, wire::Int16>>;
+    };
+} // namespace
+
+TEST_CASE("BinSchema encodes in field order", "[binschema]") {
+    STATIC_REQUIRE(Record::Schema::MIN_SIZE == 8 + 2 + 4 + 4 + 2 + 2);
+
+    Record r;
+    r.id = 0x0102030405060708;
+    r.name = "ab";
+    r.kind = Kind::B;
+    r.flag = true;
+    r.raw = std::string("\x00\xff", 2);
+    r.tail = -2;
+    REQUIRE(Record::Schema::encode(r)
+            == std::string("\x01\x02\x03\x04\x05\x06\x07\x08"
+                           "\x00\x02"
+                           "ab"
+                           "\x00\x00\x00\x02"
+                           "\x00\x00\x00\x01"
+                           "\x00\x02\x00\xff"
+                           "\xff\xfe",
+                           26));
+}
+
+TEST_CASE("BinSchema decodes what it encodes", "[binschema]") {
+    Record r;
+    r.id = -5;
+    r.name = std::string(300, 'n');
+    r.kind = Kind::B;
+    r.flag = true;
+    r.raw = "raw";
+    r.tail = 7;
+    const auto bytes = Record::Schema::encode(r) + "rest";
+
+    std::string_view view = bytes;
+    Record decoded;
+    REQUIRE(Record::Schema::decode(view, decoded));
+    REQUIRE(view == "rest");
+    REQUIRE(decoded.id == r.id);
+    REQUIRE(decoded.name == r.name);
+    REQUIRE(decoded.kind == Kind::B);
+    REQUIRE(decoded.flag);
+    REQUIRE(decoded.raw == "raw");
+    REQUIRE(decoded.tail == 7);
+}
+
+TEST_CASE("BinSchema rejects truncated records", "[binschema]") {
+    Record r;
+    r.name = "name";
+    r.raw = "raw";
+    const auto bytes = Record::Schema::encode(r);
+
+    // 在任何位置截断都应失败, 且不修改输入
+    for (size_t len = 0; len < bytes.size(); len++) {
+        std::string_view view(bytes.data(), len);
+        Record decoded;
+        REQUIRE_FALSE(Record::Schema::decode(view, decoded));
+        REQUIRE(view.size() == len);
+        REQUIRE_FALSE(Record::Schema::try_decode(view));
+    }
+    REQUIRE(Record::Schema::try_decode(bytes));
+}
+
+TEST_CASE("BinSchema truncates long strings at a character boundary", "[binschema]") {
+    Record r;
+    // "你" 在 GB18030 下为 2 字节, 65535 落在第 32768 个字符中间
+    for (auto i = 0; i < 40000; i++) r.name += u8"你";
+    r.name += u8"😀"; // 4 字节字符
+    r.raw = std::string(70000, 'x');
+
+    const auto bytes = Record::Schema::encode(r);
+    const auto decoded = Record::Schema::try_decode(bytes);
+    REQUIRE(decoded);
+    std::string expected;
+    for (auto i = 0; i < 32767; i++) expected += u8"你";
+    REQUIRE(decoded->name == expected);
+    REQUIRE(decoded->raw == std::string(UINT16_MAX, 'x')); // wire::Bytes 按字节截断
+
+    REQUIRE(_gb18030_prefix_size("a\x81\x30\x81\x30" "b", 4) == 1);
+    REQUIRE(_gb18030_prefix_size("a\x81\x30\x81\x30" "b", 5) == 5);
+    REQUIRE(_gb18030_prefix_size("\xC4\xE3\xC4\xE3", 3) == 2);
+}
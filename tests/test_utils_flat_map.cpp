@@ -0,0 +1,36 @@
+#include "../src/utils/flat_map.hpp"
+
+#include <string>
+#include <string_view>
+
+#include "catch.hpp"
+
+using cq::utils::FlatMap;
+
+TEST_CASE("FlatMap keeps keys sorted", "[flat_map]") {
+    FlatMap<std::string, std::string, 2> m{{"url", "u"}, {"title", "t"}, {"content", "c"}, {"title", "ignored"}};
+    REQUIRE(m.size() == 3);
+
+    std::string keys;
+    for (const auto &item : m) keys += item.first + ";";
+    REQUIRE(keys == "content;title;url;");
+    REQUIRE(m.at("title") == "t");
+}
+
+TEST_CASE("FlatMap lookup and modification", "[flat_map]") {
+    FlatMap<std::string, std::string, 4> m;
+    REQUIRE(m.find("qq") == m.end());
+    REQUIRE_THROWS_AS(m.at("qq"), std::out_of_range);
+
+    m["qq"] = "123";
+    REQUIRE(m.find(std::string_view("qq"))->second == "123");
+    REQUIRE_FALSE(m.emplace("qq", "456").second);
+    REQUIRE(m.insert_or_assign("qq", "456").first->second == "456");
+    REQUIRE(m.count("qq") == 1);
+
+    m.emplace("a", "1");
+    REQUIRE(m.begin()->first == "a");
+    REQUIRE(m.erase("a") == 1);
+    REQUIRE(m.erase("a") == 0);
+    REQUIRE(m == FlatMap<std::string, std::string, 4>{{"qq", "456"}});
+}
@@ -0,0 +1,123 @@
+#include "../src/utils/gb18030.hpp"
+
+#include <cstdint>
+#include <string>
+
+#include "../src/utils/string.hpp"
+#include "catch.hpp"
+
+using cq::utils::COOLQ_CSTR_BUFFER_MAX_CAPACITY;
+using cq::utils::gb18030_code_point_size;
+using cq::utils::gb18030_size;
+using cq::utils::gb18030_to_utf8;
+using cq::utils::gb18030_to_utf8_to;
+using cq::utils::utf8_to_gb18030;
+using cq::utils::string_to_coolq_cstr;
+
+static std::string utf8(const uint32_t cp) {
+    std::string s;
+    if (cp < 0x80) {
+        s += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        s += static_cast<char>(0xC0 | cp >> 6);
+        s += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        s += static_cast<char>(0xE0 | cp >> 12);
+        s += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+        s += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        s += static_cast<char>(0xF0 | cp >> 18);
+        s += static_cast<char>(0x80 | (cp >> 12 & 0x3F));
+        s += static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+        s += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+    return s;
+}
+
+TEST_CASE("GB18030 and UTF-8 convert known characters", "[gb18030]") {
+    const std::pair<std::string, std::string> cases[] = {
+        {"", ""},
+        {"hello, world", "hello, world"},
+        {u8"你好", "\xC4\xE3\xBA\xC3"},
+        {u8"€", "\xA2\xE3"}, // 双字节
+        {u8"¥", "\x81\x30\x84\x36"}, // BMP 内的四字节
+        {u8"￿", "\x84\x31\xA4\x39"}, // BMP 内最后一个四字节编码
+        {u8"😀", "\x94\x39\xFC\x36"}, // BMP 之外
+        {u8"[CQ:face,id=14] 今天的天气怎么样?", "[CQ:face,id=14] \xBD\xF1\xCC\xEC\xB5\xC4\xCC\xEC\xC6\xF8\xD4\xF5\xC3\xB4\xD1\xF9?"},
+    };
+    for (const auto &[u, gb] : cases) {
+        REQUIRE(utf8_to_gb18030(u) == gb);
+        REQUIRE(gb18030_to_utf8(gb) == u);
+    }
+}
+
+TEST_CASE("GB18030 covers every Unicode scalar value", "[gb18030]") {
+    // 期望值由 Python 的 gb18030 编解码器得出
+    std::string all_gb;
+    for (uint32_t cp = 0x80; cp <= 0x10FFFF; cp++) {
+        if (cp >= 0xD800 && cp <= 0xDFFF) continue;
+        const auto u = utf8(cp);
+        const auto gb = utf8_to_gb18030(u);
+        REQUIRE(gb18030_to_utf8(gb) == u);
+        all_gb += gb;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325; // FNV-1a
+    for (const auto ch : all_gb) {
+        hash = (hash ^ static_cast<uint8_t>(ch)) * 0x100000001b3;
+    }
+    REQUIRE(all_gb.size() == 4399864);
+    REQUIRE(hash == 0xc8fe4a1dfebeead5);
+}
+
+TEST_CASE("GB18030 size matches the converted output", "[gb18030]") {
+    REQUIRE(gb18030_code_point_size('a') == 1);
+    REQUIRE(gb18030_code_point_size(0x4F60) == 2); // 你
+    REQUIRE(gb18030_code_point_size(0x3042) == 2); // あ
+    REQUIRE(gb18030_code_point_size(0xD55C) == 4); // 한
+    REQUIRE(gb18030_code_point_size(0x1F600) == 4);
+    REQUIRE(gb18030_code_point_size(0x80) == 4);
+
+    for (const std::string s : {"", "abc", u8"你好, あ한😀\u0080", "a\xFF\xE4\xBD" "b"}) {
+        REQUIRE(gb18030_size(s) == utf8_to_gb18030(s).size());
+    }
+}
+
+TEST_CASE("GB18030 and UTF-8 replace invalid input", "[gb18030]") {
+    const std::string fffd = u8"�";
+    REQUIRE(gb18030_to_utf8("\x80") == fffd);
+    REQUIRE(gb18030_to_utf8("a\xFF" "b") == "a" + fffd + "b");
+    REQUIRE(gb18030_to_utf8("\xC4") == fffd); // 截断的双字节字符
+    REQUIRE(gb18030_to_utf8("a\x81\x30" "b") == "a" + fffd + "0b"); // 截断的四字节字符
+    REQUIRE(gb18030_to_utf8("\x85\x30\x81\x30") == fffd + "0" + fffd + "0"); // 未分配的四字节编码
+
+    // 全部为非法字节时结果比预留的空间长
+    std::string out = "x";
+    gb18030_to_utf8_to(out, std::string(100, '\x80'));
+    std::string expected = "x";
+    for (auto i = 0; i < 100; i++) expected += fffd;
+    REQUIRE(out == expected);
+
+    REQUIRE(utf8_to_gb18030("\xC0\x80") == "??"); // 过长编码
+    REQUIRE(utf8_to_gb18030("\xED\xA0\x80") == "???"); // 代理码位
+    REQUIRE(utf8_to_gb18030("\xF4\x90\x80\x80") == "????"); // 超出 U+10FFFF
+    REQUIRE(utf8_to_gb18030("a\xE4\xBD" "b") == "a??b"); // 截断
+}
+
+TEST_CASE("per-thread coolq buffers are reused", "[gb18030]") {
+    const auto tag = string_to_coolq_cstr<0>(u8"标签");
+    const auto msg = string_to_coolq_cstr<1>(u8"消息 text");
+    REQUIRE(std::string(tag) == "\xB1\xEA\xC7\xA9");
+    REQUIRE(std::string(msg) == "\xCF\xFB\xCF\xA2 text");
+
+    // 较短的字符串复用同一缓冲区, 且不影响其他 Slot
+    REQUIRE(string_to_coolq_cstr<0>("abc") == tag);
+    REQUIRE(std::string(tag) == "abc");
+    REQUIRE(std::string(msg) == "\xCF\xFB\xCF\xA2 text");
+    REQUIRE(std::string(string_to_coolq_cstr<0>("")).empty());
+
+    // 超长字符串之后缓冲区被释放, 内容仍然正确
+    const std::string large(COOLQ_CSTR_BUFFER_MAX_CAPACITY + 1, 'x');
+    REQUIRE(string_to_coolq_cstr<0>(large) == large);
+    REQUIRE(std::string(string_to_coolq_cstr<0>("ok")) == "ok");
+}
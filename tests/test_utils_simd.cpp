@@ -0,0 +1,27 @@
+#include "../src/utils/simd.hpp"
+
+#include <string>
+
+#include "catch.hpp"
+
+using cq::utils::simd::find_any_of;
+
+TEST_CASE("find_any_of", "[simd]") {
+    // 覆盖 SSE2/AVX2 分块和逐字节处理的尾部
+    for (size_t len = 0; len <= 100; len++) {
+        const std::string str(len, 'x');
+        const auto first = str.data(), last = first + len;
+        REQUIRE(find_any_of(first, last, '&', '[', ']', ',') == last);
+
+        for (size_t pos = 0; pos < len; pos++) {
+            auto s = str;
+            s[pos] = ",[]&"[pos % 4];
+            if (pos + 1 < len) s[pos + 1] = '&';
+            REQUIRE(find_any_of(s.data(), s.data() + len, '&', '[', ']', ',') == s.data() + pos);
+        }
+    }
+
+    // 非 ASCII 字节不应被误判
+    const std::string utf8 = "\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xbd\xa0\xe5\xa5\xbd\xe4\xbd\xa0\xe5\xa5\xbd, world";
+    REQUIRE(find_any_of(utf8.data(), utf8.data() + utf8.size(), '&', '[', ']', ',') == utf8.data() + 18);
+}
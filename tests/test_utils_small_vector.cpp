@@ -0,0 +1,71 @@
+#include "../src/utils/small_vector.hpp"
+
+#include <string>
+
+#include "catch.hpp"
+
+using cq::utils::SmallVector;
+
+TEST_CASE("SmallVector inline and heap storage", "[small_vector]") {
+    SmallVector<std::string, 2> v;
+    REQUIRE(v.empty());
+    REQUIRE(v.is_inline());
+
+    v.push_back("a");
+    v.emplace_back("b");
+    REQUIRE(v.is_inline());
+    REQUIRE(v.size() == 2);
+
+    v.push_back(v.front()); // 引用自身元素时触发扩容
+    REQUIRE_FALSE(v.is_inline());
+    REQUIRE(v == SmallVector<std::string, 2>{"a", "b", "a"});
+
+    v.erase(v.begin() + 1);
+    REQUIRE(v == SmallVector<std::string, 2>{"a", "a"});
+    v.shrink_to_fit();
+    REQUIRE(v.is_inline());
+    REQUIRE(v.back() == "a");
+}
+
+TEST_CASE("SmallVector insert and erase", "[small_vector]") {
+    SmallVector<int, 4> v{1, 5};
+    const int mid[] = {2, 3, 4};
+    v.insert(v.begin() + 1, std::begin(mid), std::end(mid));
+    REQUIRE(v == SmallVector<int, 4>{1, 2, 3, 4, 5});
+
+    v.insert(v.begin(), 0);
+    v.erase(v.begin() + 2, v.begin() + 4);
+    REQUIRE(v == SmallVector<int, 4>{0, 1, 4, 5});
+
+    v.resize(6);
+    REQUIRE(v.size() == 6);
+    REQUIRE(v[5] == 0);
+    v.resize(1);
+    REQUIRE(v == SmallVector<int, 4>{0});
+
+    // 插入自身的元素, 且需要重新分配存储
+    SmallVector<std::string, 2> s{"a", "b"};
+    s.insert(s.end(), s.begin(), s.end());
+    REQUIRE(s == SmallVector<std::string, 2>{"a", "b", "a", "b"});
+}
+
+TEST_CASE("SmallVector copy and move", "[small_vector]") {
+    SmallVector<std::string, 2> small{"x"};
+    SmallVector<std::string, 2> big{"x", "y", "z"};
+
+    auto small_copy = small;
+    auto big_copy = big;
+    REQUIRE(small_copy == small);
+    REQUIRE(big_copy == big);
+
+    auto small_moved = std::move(small_copy);
+    auto big_moved = std::move(big_copy);
+    REQUIRE(small_moved == small);
+    REQUIRE(big_moved == big);
+    REQUIRE(small_copy.empty());
+    REQUIRE(big_copy.empty());
+
+    small_moved.swap(big_moved);
+    REQUIRE(small_moved == big);
+    REQUIRE(big_moved == small);
+}
@@ -0,0 +1,65 @@
+#include "../src/utils/unicode.hpp"
+
+#include <string>
+
+#include "../src/utils/string.hpp"
+#include "catch.hpp"
+
+using namespace cq::utils;
+
+template <typename CharT>
+static std::basic_string<CharT> widen(const std::string_view utf8) {
+    std::basic_string<CharT> out;
+    utf8_to_wide_to(out, utf8);
+    return out;
+}
+
+template <typename CharT>
+static std::string narrow(const std::basic_string<CharT> &wide) {
+    std::string out;
+    wide_to_utf8_to(out, std::basic_string_view<CharT>(wide));
+    return out;
+}
+
+TEST_CASE("UTF-8 converts to and from UTF-16 and UTF-32", "[unicode]") {
+    // 长度超过一组 SIMD 处理的字节数, 且 ASCII 与非 ASCII 交替
+    const std::string utf8 = u8"hello, 世界! [CQ:face,id=14] 😀 ASCII tail that is long enough, é";
+    const std::u16string utf16 = u"hello, 世界! [CQ:face,id=14] 😀 ASCII tail that is long enough, é";
+    const std::u32string utf32 = U"hello, 世界! [CQ:face,id=14] 😀 ASCII tail that is long enough, é";
+
+    REQUIRE(widen<char16_t>(utf8) == utf16);
+    REQUIRE(widen<char32_t>(utf8) == utf32);
+    REQUIRE(narrow(utf16) == utf8);
+    REQUIRE(narrow(utf32) == utf8);
+
+    REQUIRE(s2ws(utf8) == L"hello, 世界! [CQ:face,id=14] 😀 ASCII tail that is long enough, é");
+    REQUIRE(ws2s(s2ws(utf8)) == utf8);
+    REQUIRE(ws2s(L"") == "");
+
+    // 追加到已有内容之后
+    std::u16string out = u"x";
+    utf8_to_wide_to(out, "yz");
+    REQUIRE(out == u"xyz");
+}
+
+TEST_CASE("UTF-8 round trips every code point", "[unicode]") {
+    std::u32string all;
+    for (char32_t cp = 0; cp <= 0x10FFFF; cp++) {
+        if (cp < 0xD800 || cp > 0xDFFF) all += cp;
+    }
+    const auto utf8 = narrow(all);
+    REQUIRE(widen<char32_t>(utf8) == all);
+    REQUIRE(narrow(widen<char16_t>(utf8)) == utf8);
+}
+
+TEST_CASE("invalid input is replaced with U+FFFD", "[unicode]") {
+    REQUIRE(widen<char16_t>("a\xC0\x80z") == u"a��z");
+    REQUIRE(widen<char16_t>("\xED\xA0\x80") == u"���");
+    REQUIRE(widen<char32_t>("\xE4\xBD") == U"��");
+
+    const std::string fffd = u8"�";
+    REQUIRE(narrow(std::u16string{u'a', 0xD800, u'b'}) == "a" + fffd + "b"); // 不成对的高代理项
+    REQUIRE(narrow(std::u16string{0xDC00, u'b'}) == fffd + "b"); // 单独的低代理项
+    REQUIRE(narrow(std::u16string{u'a', 0xD83D}) == "a" + fffd); // 结尾的高代理项
+    REQUIRE(narrow(std::u32string{0xD800, 0x110000, U'c'}) == fffd + fffd + "c");
+}